@@ -4,6 +4,267 @@ from mpl_toolkits.mplot3d import Axes3D
 import json
 from numba import njit
 import asyncio
+import ctypes
+import os
+import sys
+import threading
+
+_WINDOWS = ["rectangular", "hann", "hamming", "blackman_harris", "taylor", "chebyshev", "kaiser"]
+_CFAR_TYPES = ["ca", "go", "so", "os"]
+
+
+class _Context:
+    """
+    A native context (scratch memory and detection lists) owned by one Python thread.
+    """
+    def __init__(self, lib):
+        self.lib = lib
+        self.handle = lib.radar_context_create(0)
+        if not self.handle:
+            raise MemoryError("radar_context_create failed")
+
+    def __del__(self):
+        self.lib.radar_context_destroy(self.handle)
+
+
+class NativeReference:
+    """
+    A reference spectrum prepared once by the native library and reused across matched-filter calls.
+    """
+    def __init__(self, kernels, reference, window="rectangular", fft_size=0):
+        """
+        :param kernels: NativeKernels instance
+        :param reference: 1-D complex reference waveform
+        :param window: Range window applied to the reference
+        :param fft_size: Overlap-save block size (0 picks four times the reference length)
+        """
+        self.lib = kernels.lib
+        self.dtype = kernels._complex_dtype(reference)
+        reference = np.asarray(reference, dtype=self.dtype)
+        create = self.lib.radar_reference_create_f if self.dtype == np.complex64 else self.lib.radar_reference_create
+        self.handle = create(reference.ctypes.data, len(reference), kernels._stride(reference), fft_size,
+                             _WINDOWS.index(window), 0.0)
+        if not self.handle:
+            raise ValueError("could not prepare the reference")
+
+    def __del__(self):
+        if getattr(self, "handle", None):
+            if self.dtype == np.complex64:
+                self.lib.radar_reference_destroy_f(self.handle)
+            else:
+                self.lib.radar_reference_destroy(self.handle)
+
+
+class NativeKernels:
+    """
+    The C++ matched filter, CFAR and range-Doppler kernels, called through the toolkit's C interface
+    (libradar_toolkit) on NumPy arrays without copying them. complex64 arrays run the float kernels and
+    everything else the double ones. ctypes releases the GIL for the duration of each call, so several Python
+    threads can process in parallel; each gets its own native context.
+    """
+    def __init__(self, path):
+        """
+        :param path: Path to the shared library
+        """
+        self.lib = ctypes.CDLL(path)
+        self._declare()
+        if self.lib.radar_api_version() != 1:
+            raise OSError("unsupported radar_toolkit C API version")
+        self._local = threading.local()
+
+    @classmethod
+    def load(cls, path=None):
+        """
+        Load the library from path, $RADAR_TOOLKIT_LIB or next to this file.
+        :param path: Optional explicit path to the shared library
+        :return: NativeKernels, or None if the library is not available
+        """
+        if path is None:
+            path = os.environ.get("RADAR_TOOLKIT_LIB")
+        if path is None:
+            name = {"win32": "radar_toolkit.dll", "darwin": "libradar_toolkit.dylib"}.get(sys.platform,
+                                                                                          "libradar_toolkit.so")
+            path = os.path.join(os.path.dirname(os.path.abspath(__file__)), name)
+        try:
+            return cls(path)
+        except OSError:
+            return None
+
+    def _declare(self):
+        c = ctypes
+        p, size, stride, status, count = c.c_void_p, c.c_size_t, c.c_ssize_t, c.c_int, c.c_ssize_t
+        untyped = {
+            "radar_api_version": (status, []),
+            "radar_status_message": (c.c_char_p, [status]),
+            "radar_context_create": (p, [size]),
+            "radar_context_destroy": (None, [p]),
+        }
+        # Each of these also has a float variant with the same signature and an _f suffix.
+        typed = {
+            "radar_reference_create": (p, [p, size, stride, size, status, c.c_double]),
+            "radar_reference_destroy": (None, [p]),
+            "radar_matched_filter": (status, [p, p, p, stride, p, stride, size]),
+            "radar_matched_filter_cpi": (status, [p, p, p, size, size, stride]),
+            "radar_range_doppler": (status, [p, p, size, size, stride, status, c.c_double, p]),
+            "radar_cfar": (count, [p, p, size, stride, size, size, c.c_double, status, size, p, size]),
+            "radar_cfar_2d": (count, [p, p, size, size, size, size, size, size, c.c_double, p, p, size]),
+        }
+        signatures = dict(untyped)
+        for name, signature in typed.items():
+            signatures[name] = signature
+            signatures[name + "_f"] = signature
+        for name, (restype, argtypes) in signatures.items():
+            function = getattr(self.lib, name)
+            function.restype = restype
+            function.argtypes = argtypes
+
+    def _context(self):
+        context = getattr(self._local, "context", None)
+        if context is None:
+            context = self._local.context = _Context(self.lib)
+        return context.handle
+
+    def _check(self, result):
+        if result < 0:
+            raise RuntimeError(self.lib.radar_status_message(result).decode())
+        return result
+
+    def _function(self, name, dtype):
+        return getattr(self.lib, name + "_f" if dtype in (np.complex64, np.float32) else name)
+
+    @staticmethod
+    def _complex_dtype(array):
+        return np.complex64 if np.asarray(array).dtype in (np.complex64, np.float32) else np.complex128
+
+    @staticmethod
+    def _stride(array):
+        """
+        Stride of a 1-D array in samples; arrays whose stride is not a whole number of samples are copied.
+        """
+        return array.strides[0] // array.itemsize
+
+    def _vector(self, array, dtype):
+        array = np.asarray(array, dtype=dtype)
+        if array.ndim != 1:
+            raise ValueError("expected a 1-D array")
+        if array.strides[0] % array.itemsize:
+            array = np.ascontiguousarray(array)
+        return array
+
+    def _cpi(self, pulses, dtype, writable=False):
+        """
+        A 2-D array (pulses x samples) whose rows are contiguous, as the C interface reads it.
+        """
+        array = np.asarray(pulses, dtype=dtype)
+        if array.ndim != 2:
+            raise ValueError("expected a 2-D array of pulses x samples")
+        if array.strides[1] != array.itemsize or array.strides[0] % array.itemsize:
+            if writable:
+                raise ValueError("pulses must have contiguous rows to be compressed in place")
+            array = np.ascontiguousarray(array)
+        return array
+
+    def prepare_reference(self, reference, window="rectangular", fft_size=0):
+        """
+        :param reference: 1-D complex reference waveform
+        :param window: Range window: rectangular, hann, hamming, blackman_harris, taylor, chebyshev or kaiser
+        :param fft_size: Overlap-save block size (0 picks four times the reference length)
+        :return: NativeReference
+        """
+        return NativeReference(self, reference, window, fft_size)
+
+    def matched_filter(self, signal, reference, out=None):
+        """
+        Correlate a signal with a reference; the first len(signal) lags.
+        :param signal: 1-D complex signal
+        :param reference: Reference waveform or NativeReference
+        :param out: Optional output array, which may be the signal itself
+        :return: Compressed signal
+        """
+        if not isinstance(reference, NativeReference):
+            reference = self.prepare_reference(reference)
+        signal = self._vector(signal, reference.dtype)
+        if out is None:
+            out = np.empty_like(signal)
+        elif out.dtype != reference.dtype or out.shape != signal.shape or out.strides[0] % out.itemsize:
+            raise ValueError("out must be a 1-D array of the signal's length and dtype")
+        self._check(self._function("radar_matched_filter", reference.dtype)(
+            self._context(), reference.handle, signal.ctypes.data, self._stride(signal), out.ctypes.data,
+            self._stride(out), len(signal)))
+        return out
+
+    def matched_filter_cpi(self, pulses, reference):
+        """
+        Range-compress every pulse of a CPI in place.
+        :param pulses: 2-D complex array (pulses x samples) with contiguous rows
+        :param reference: Reference waveform or NativeReference
+        :return: The same array
+        """
+        if not isinstance(reference, NativeReference):
+            reference = self.prepare_reference(reference, "rectangular")
+        if pulses.dtype != reference.dtype:
+            raise ValueError("pulses and reference must have the same dtype")
+        pulses = self._cpi(pulses, reference.dtype, writable=True)
+        self._check(self._function("radar_matched_filter_cpi", reference.dtype)(
+            self._context(), reference.handle, pulses.ctypes.data, pulses.shape[0], pulses.shape[1],
+            pulses.strides[0] // pulses.itemsize))
+        return pulses
+
+    def range_doppler_map(self, pulses, window="hann"):
+        """
+        Windowed slow-time FFT magnitudes of a CPI.
+        :param pulses: 2-D complex array (pulses x samples)
+        :param window: Doppler window
+        :return: Magnitudes (range bins x Doppler bins), zero velocity at column pulses // 2
+        """
+        dtype = self._complex_dtype(pulses)
+        pulses = self._cpi(pulses, dtype)
+        real_dtype = np.float32 if dtype == np.complex64 else np.float64
+        magnitudes = np.empty((pulses.shape[1], pulses.shape[0]), dtype=real_dtype)
+        self._check(self._function("radar_range_doppler", dtype)(
+            self._context(), pulses.ctypes.data, pulses.shape[0], pulses.shape[1],
+            pulses.strides[0] // pulses.itemsize, _WINDOWS.index(window), 0.0, magnitudes.ctypes.data))
+        return magnitudes
+
+    def cfar(self, signal, guard_cells, training_cells, pfa, cfar_type="ca", os_rank=0):
+        """
+        :param signal: 1-D complex signal (square-law detected internally)
+        :param guard_cells: Guard cells on each side
+        :param training_cells: Training cells on each side
+        :param pfa: Probability of false alarm
+        :param cfar_type: ca, go, so or os
+        :param os_rank: Rank for order-statistic CFAR (0 picks 3/4 of the window)
+        :return: Indices of detected cells
+        """
+        dtype = self._complex_dtype(signal)
+        signal = self._vector(signal, dtype)
+        detections = np.empty(len(signal), dtype=np.uintp)
+        found = self._check(self._function("radar_cfar", dtype)(
+            self._context(), signal.ctypes.data, len(signal), self._stride(signal), guard_cells, training_cells, pfa,
+            _CFAR_TYPES.index(cfar_type), os_rank, detections.ctypes.data, len(detections)))
+        return detections[:found]
+
+    def cfar_2d(self, magnitudes, guard_range, guard_doppler, training_range, training_doppler, pfa):
+        """
+        Cell-averaging CFAR over a range-Doppler magnitude map.
+        :param magnitudes: 2-D real array (range bins x Doppler bins)
+        :return: Arrays of range bins and Doppler bins of the detections
+        """
+        dtype = np.float32 if np.asarray(magnitudes).dtype == np.float32 else np.float64
+        magnitudes = np.ascontiguousarray(magnitudes, dtype=dtype)
+        function = self._function("radar_cfar_2d", dtype)
+        capacity = 1024
+        while True:
+            range_bins = np.empty(capacity, dtype=np.uintp)
+            doppler_bins = np.empty(capacity, dtype=np.uintp)
+            found = self._check(function(
+                self._context(), magnitudes.ctypes.data, magnitudes.shape[0], magnitudes.shape[1], guard_range,
+                guard_doppler, training_range, training_doppler, pfa, range_bins.ctypes.data, doppler_bins.ctypes.data,
+                capacity))
+            if found <= capacity:
+                return range_bins[:found], doppler_bins[:found]
+            capacity = found
+
 
 class RadarSignalProcessor:
     def __init__(self, fc=24e9, B=250e6, T=50e-6, fs=10e6):
@@ -19,6 +280,8 @@ class RadarSignalProcessor:
         self.T = T
         self.fs = fs
         self.c = 3e8  # Speed of light (m/s)
+        # C++ kernels for matched filtering, CFAR and range-Doppler processing; None falls back to NumPy.
+        self.native = NativeKernels.load()
 
     def generate_chirp(self):
         """
@@ -116,6 +379,53 @@ class RadarSignalProcessor:
         detected_targets = np.abs(fft_result) > threshold
         return detected_targets
 
+    def matched_filter(self, signal, reference):
+        """
+        Pulse-compress a signal against a reference waveform.
+        :param signal: Received signal
+        :param reference: Transmitted waveform
+        :return: First len(signal) lags of the correlation with the reference
+        """
+        if self.native is not None:
+            return self.native.matched_filter(signal, reference)
+        n = len(signal) + len(reference) - 1
+        size = 1 << (n - 1).bit_length()
+        return np.fft.ifft(np.fft.fft(signal, size) * np.conj(np.fft.fft(reference, size)))[:len(signal)]
+
+    def cfar_detect(self, signal, guard_cells, training_cells, pfa):
+        """
+        Cell-averaging CFAR on the signal's power, with the threshold set for a false-alarm probability.
+        :param signal: Complex signal (e.g. matched filter output)
+        :param guard_cells: Number of guard cells on each side
+        :param training_cells: Number of training cells on each side
+        :param pfa: Probability of false alarm
+        :return: Indices of detected cells
+        """
+        if self.native is not None:
+            return self.native.cfar(signal, guard_cells, training_cells, pfa)
+        power = np.abs(signal)**2
+        reach = guard_cells + training_cells
+        total = 2 * training_cells
+        threshold_factor = total * (pfa ** (-1 / total) - 1)
+        prefix = np.concatenate(([0.0], np.cumsum(power)))
+        cells = np.arange(reach, len(power) - reach)
+        leading = prefix[cells - guard_cells] - prefix[cells - reach]
+        lagging = prefix[cells + reach + 1] - prefix[cells + guard_cells + 1]
+        return cells[power[cells] > (leading + lagging) / total * threshold_factor]
+
+    def range_doppler(self, pulses, window="hann"):
+        """
+        Doppler-process a range-compressed CPI.
+        :param pulses: 2-D array (pulses x samples)
+        :param window: Doppler window: rectangular, hann or hamming (any of the C++ windows natively)
+        :return: Magnitudes (range bins x Doppler bins), zero velocity at column pulses // 2
+        """
+        if self.native is not None:
+            return self.native.range_doppler_map(pulses, window)
+        taper = {"rectangular": np.ones, "hann": np.hanning, "hamming": np.hamming}[window](len(pulses))
+        spectrum = np.fft.fftshift(np.fft.fft(pulses * taper[:, None], axis=0), axes=0)
+        return np.abs(spectrum).T
+
     def process_multiple_targets(self, targets, snr_db=20, clutter_power=0.1):
         """
         Process multiple targets and generate a Range-Doppler Map.
@@ -0,0 +1,389 @@
+#include "benchmark.h"
+#include "signal_generator.h"
+#include "signal_processor.h"
+#include "file_io.h"
+#include "random.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+#include "mti_filter.h"
+#include "target_extractor.h"
+#include "signal_analyzer.h"
+#include "clutter_model.h"
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <memory>
+#include <type_traits>
+#include <unistd.h>
+
+namespace RadarToolkit {
+
+namespace {
+
+constexpr double BENCH_FS = 100.0e6;
+constexpr size_t REFERENCE_SIZE = 256;
+constexpr size_t NUM_PULSES = 64;
+
+template <typename T> const char* typeName();
+template <> const char* typeName<float>() { return "float"; }
+template <> const char* typeName<double>() { return "double"; }
+
+template <typename T>
+std::string caseName(const char* operation) {
+    return std::string(operation) + "<" + typeName<T>() + ">";
+}
+
+template <typename T>
+std::vector<std::complex<T>> noise(size_t size, uint64_t stream) {
+    std::vector<std::complex<T>> signal(size);
+    RandomStream(1, stream).addComplexGaussian<T>(signal, T(1));
+    return signal;
+}
+
+double fftFlops(size_t n) {
+    return 5.0 * n * std::log2(static_cast<double>(n));
+}
+
+// Removed when the benchmark body that captured it is destroyed.
+struct TempFile {
+    std::string path;
+    explicit TempFile(const char* extension)
+        : path((std::filesystem::temp_directory_path() /
+                ("radar_benchmark_" + std::to_string(getpid()) + extension)).string()) {}
+    ~TempFile() { std::remove(path.c_str()); }
+};
+
+// Counters model compulsory work: flops of the textbook operation count (transcendentals excluded)
+// and bytes of inputs read plus outputs written once.
+template <typename T>
+void addCases(std::vector<BenchmarkCase>& cases) {
+    constexpr double sample_bytes = sizeof(std::complex<T>);
+
+    cases.push_back({caseName<T>("generateChirp"), [](size_t size, BenchmarkCounters& counters) {
+        double duration = size / BENCH_FS;
+        counters.samples = size;
+        counters.flops = 12.0 * size;
+        counters.bytes = sample_bytes * size;
+        return std::function<void()>([duration] {
+            auto chirp = BasicSignalGenerator<T>::generateChirp(0.0, BENCH_FS / 2, duration, BENCH_FS);
+        });
+    }});
+
+    cases.push_back({caseName<T>("addNoise"), [](size_t size, BenchmarkCounters& counters) {
+        auto signal = std::make_shared<std::vector<std::complex<T>>>(noise<T>(size, 0));
+        counters.samples = size;
+        counters.flops = 8.0 * size;
+        counters.bytes = 3 * sample_bytes * size;
+        // At 60 dB SNR the signal power creeps up by only 1e-6 per iteration.
+        return std::function<void()>([signal] {
+            BasicSignalGenerator<T>::addNoise(*signal, 60.0, RandomStream(2));
+        });
+    }, 0, ~size_t{0}, true});
+
+    // Spiky K clutter (shape 0.5) on a single signal, 60 dB below it for the same reason.
+    cases.push_back({caseName<T>("addClutterK"), [](size_t size, BenchmarkCounters& counters) {
+        auto signal = std::make_shared<std::vector<std::complex<T>>>(noise<T>(size, 0));
+        counters.samples = size;
+        counters.bytes = 3 * sample_bytes * size;
+        return std::function<void()>([signal] {
+            ClutterModel model;
+            model.amplitude = ClutterAmplitude::KDistributed;
+            model.shape = 0.5;
+            BasicClutterGenerator<T>::addClutter(*signal, -60.0, model, RandomStream(3));
+        });
+    }, 0, ~size_t{0}, true});
+
+    cases.push_back({caseName<T>("matchedFilterDirect"), [](size_t size, BenchmarkCounters& counters) {
+        auto signal = std::make_shared<std::vector<std::complex<T>>>(noise<T>(size, 0));
+        auto reference = std::make_shared<std::vector<std::complex<T>>>(noise<T>(REFERENCE_SIZE, 1));
+        counters.samples = size;
+        counters.flops = 8.0 * size * REFERENCE_SIZE;
+        counters.bytes = 2 * sample_bytes * size;
+        return std::function<void()>([signal, reference] {
+            auto output = BasicSignalProcessor<T>::matchedFilterDirect(*signal, *reference);
+        });
+    }, 0, size_t{1} << 20});
+
+    cases.push_back({caseName<T>("matchedFilterFFT"), [](size_t size, BenchmarkCounters& counters) {
+        auto signal = std::make_shared<std::vector<std::complex<T>>>(noise<T>(size, 0));
+        auto output = std::make_shared<std::vector<std::complex<T>>>(size);
+        auto reference = std::make_shared<BasicReferenceSpectrum<T>>(
+            BasicSignalProcessor<T>::prepareReference(noise<T>(REFERENCE_SIZE, 1)));
+        size_t n = reference->fft_size;
+        size_t blocks = (size + n - REFERENCE_SIZE) / (n - REFERENCE_SIZE + 1);
+        counters.samples = size;
+        counters.flops = blocks * (2 * fftFlops(n) + 6.0 * n);
+        counters.bytes = 2 * sample_bytes * size;
+        return std::function<void()>([signal, output, reference] {
+            BasicSignalProcessor<T>::matchedFilter(*signal, *reference, *output);
+        });
+    }});
+
+    cases.push_back({caseName<T>("cfarDetection"), [](size_t size, BenchmarkCounters& counters) {
+        auto signal = std::make_shared<std::vector<std::complex<T>>>(noise<T>(size, 0));
+        counters.samples = size;
+        counters.flops = 8.0 * size;
+        counters.bytes = sample_bytes * size;
+        return std::function<void()>([signal] {
+            auto detections = BasicSignalProcessor<T>::cfarDetection(*signal, 2, 16, 1e-6);
+        });
+    }});
+
+    // A forward and an inverse transform, rescaled so repeated iterations stay finite.
+    cases.push_back({caseName<T>("fft"), [](size_t size, BenchmarkCounters& counters) {
+        auto data = std::make_shared<std::vector<std::complex<T>>>(noise<T>(size, 0));
+        counters.samples = 2.0 * size;
+        counters.flops = 2 * fftFlops(size) + 2.0 * size;
+        counters.bytes = 4 * sample_bytes * size;
+        return std::function<void()>([data] {
+            BasicSignalProcessor<T>::fft(*data);
+            BasicSignalProcessor<T>::fft(*data, true);
+            T scale = T(1) / static_cast<T>(data->size());
+            for (auto& value : *data) value *= scale;
+        });
+    }});
+
+    // A dense 256-velocity search over a +/-150 m/s sub-band; Auto picks the chirp-z zoom at larger sizes.
+    cases.push_back({caseName<T>("dopplerFilterBank"), [](size_t size, BenchmarkCounters& counters) {
+        auto signal = std::make_shared<std::vector<std::complex<T>>>(noise<T>(size, 0));
+        size_t fft_size = BasicFFTPlan<T>::nextPowerOfTwo(size + 256);
+        counters.samples = size;
+        counters.flops = std::min(4.0 * 256 * size, 3 * fftFlops(fft_size) + 40.0 * fft_size);
+        counters.bytes = sample_bytes * size;
+        return std::function<void()>([signal] {
+            auto spectrum = BasicSignalProcessor<T>::dopplerFilterBank(*signal, 1.0e9, 1.0e3, -150.0, 150.0, 256);
+        });
+    }});
+
+    cases.push_back({caseName<T>("rangeDopplerMap"), [](size_t size, BenchmarkCounters& counters) {
+        auto pulses = std::make_shared<BasicPulseMatrix<T>>(NUM_PULSES, size / NUM_PULSES);
+        RandomStream(1).addComplexGaussian<T>(pulses->samples(), T(1));
+        counters.samples = size;
+        counters.flops = (size / NUM_PULSES) * fftFlops(NUM_PULSES) + 5.0 * size;
+        counters.bytes = (sample_bytes + sizeof(T)) * size;
+        return std::function<void()>([pulses] {
+            auto map = BasicSignalProcessor<T>::rangeDopplerMap(*pulses, 1.0e9, BENCH_FS, 1.0e3);
+        });
+    }, NUM_PULSES * NUM_PULSES, ~size_t{0}, true});
+
+    // Three-pulse canceller with a clutter map; each iteration first restores the CPI the filter shrank.
+    cases.push_back({caseName<T>("mtiFilter"), [](size_t size, BenchmarkCounters& counters) {
+        auto source = std::make_shared<BasicPulseMatrix<T>>(NUM_PULSES, size / NUM_PULSES);
+        RandomStream(1).addComplexGaussian<T>(source->samples(), T(1));
+        auto pulses = std::make_shared<BasicPulseMatrix<T>>();
+        auto filter = std::make_shared<BasicMTIFilter<T>>(MTIConfig{MTIType::ThreePulse, {}, true});
+        counters.samples = size;
+        counters.flops = 18.0 * size;
+        counters.bytes = 2 * sample_bytes * size;
+        return std::function<void()>([source, pulses, filter] {
+            *pulses = *source;
+            filter->apply(*pulses);
+        });
+    }, NUM_PULSES * NUM_PULSES, ~size_t{0}, true});
+
+    // Clusters the detections of a 2-D CFAR run at pfa 1e-2 on a noise map, so there are many small targets.
+    cases.push_back({caseName<T>("extractTargets"), [](size_t size, BenchmarkCounters& counters) {
+        BasicPulseMatrix<T> pulses(NUM_PULSES, size / NUM_PULSES);
+        RandomStream(1).addComplexGaussian<T>(pulses.samples(), T(1));
+        auto map = std::make_shared<BasicRangeDopplerMap<T>>(
+            BasicSignalProcessor<T>::rangeDopplerMap(pulses, 1.0e9, BENCH_FS, 1.0e3));
+        auto hits = std::make_shared<std::vector<Detection2D>>(
+            BasicSignalProcessor<T>::cfarDetection2D(*map, 1, 1, 4, 4, 1e-2));
+        auto extractor = std::make_shared<BasicTargetExtractor<T>>();
+        counters.samples = hits->size();
+        counters.bytes = sizeof(Detection2D) * hits->size();
+        return std::function<void()>([map, hits, extractor] {
+            extractor->extract(*map, *hits);
+        });
+    }, NUM_PULSES * NUM_PULSES});
+
+    // SignalAnalyzer works on double captures only.
+    if constexpr (std::is_same_v<T, double>) {
+        cases.push_back({caseName<T>("computeStats"), [](size_t size, BenchmarkCounters& counters) {
+            auto signal = std::make_shared<std::vector<std::complex<T>>>(noise<T>(size, 0));
+            counters.samples = size;
+            counters.flops = 4.0 * size;
+            counters.bytes = sample_bytes * size;
+            return std::function<void()>([signal] {
+                SignalAnalyzer::computeStats(*signal);
+            });
+        }});
+    }
+
+    cases.push_back({caseName<T>("saveBinary"), [](size_t size, BenchmarkCounters& counters) {
+        auto signal = std::make_shared<std::vector<std::complex<T>>>(noise<T>(size, 0));
+        auto file = std::make_shared<TempFile>(".iq");
+        counters.samples = size;
+        counters.bytes = sample_bytes * size;
+        return std::function<void()>([signal, file] {
+            BasicFileIO<T>::saveBinary(*signal, file->path);
+        });
+    }});
+
+    cases.push_back({caseName<T>("loadBinary"), [](size_t size, BenchmarkCounters& counters) {
+        auto file = std::make_shared<TempFile>(".iq");
+        BasicFileIO<T>::saveBinary(noise<T>(size, 0), file->path);
+        auto pulses = std::make_shared<BasicPulseMatrix<T>>();
+        counters.samples = size;
+        counters.bytes = sample_bytes * size;
+        return std::function<void()>([pulses, file] {
+            BasicFileIO<T>::loadBinary(file->path, *pulses);
+        });
+    }});
+
+    cases.push_back({caseName<T>("saveSignal"), [](size_t size, BenchmarkCounters& counters) {
+        auto signal = std::make_shared<std::vector<std::complex<T>>>(noise<T>(size, 0));
+        auto file = std::make_shared<TempFile>(".csv");
+        counters.samples = size;
+        counters.bytes = sample_bytes * size;
+        return std::function<void()>([signal, file] {
+            BasicFileIO<T>::saveSignal(*signal, file->path);
+        });
+    }, 0, size_t{1} << 20});
+
+    cases.push_back({caseName<T>("loadSignal"), [](size_t size, BenchmarkCounters& counters) {
+        auto file = std::make_shared<TempFile>(".csv");
+        BasicFileIO<T>::saveSignal(noise<T>(size, 0), file->path);
+        counters.samples = size;
+        counters.bytes = sample_bytes * size;
+        return std::function<void()>([file] {
+            auto signal = BasicFileIO<T>::loadSignal(file->path);
+        });
+    }, 0, size_t{1} << 20});
+}
+
+std::string stringField(const std::string& line, const std::string& key) {
+    size_t at = line.find("\"" + key + "\":");
+    if (at == std::string::npos) return {};
+    size_t begin = line.find('"', at + key.size() + 3);
+    size_t end = begin == std::string::npos ? begin : line.find('"', begin + 1);
+    if (end == std::string::npos) return {};
+    return line.substr(begin + 1, end - begin - 1);
+}
+
+double numberField(const std::string& line, const std::string& key) {
+    size_t at = line.find("\"" + key + "\":");
+    if (at == std::string::npos) return 0.0;
+    return std::strtod(line.c_str() + at + key.size() + 3, nullptr);
+}
+
+}
+
+std::vector<BenchmarkCase> Benchmark::standardSuite() {
+    std::vector<BenchmarkCase> cases;
+    addCases<float>(cases);
+    addCases<double>(cases);
+    return cases;
+}
+
+std::vector<BenchmarkResult> Benchmark::run(const std::vector<BenchmarkCase>& cases, const BenchmarkOptions& options,
+                                            const std::function<void(const BenchmarkResult&)>& on_result) {
+    using Clock = std::chrono::steady_clock;
+    std::vector<BenchmarkResult> results;
+    size_t multiplier = std::max<size_t>(options.size_multiplier, 2);
+
+    for (const auto& benchmark_case : cases) {
+        if (benchmark_case.name.find(options.filter) == std::string::npos) continue;
+        for (size_t size = options.min_size; size <= options.max_size; size *= multiplier) {
+            if (size < benchmark_case.min_size || size > benchmark_case.max_size) continue;
+            std::vector<size_t> thread_counts = benchmark_case.threaded ? options.threads : std::vector<size_t>{1};
+            for (size_t threads : thread_counts) {
+                ThreadPool pool(threads);
+                ThreadPool::Scope scope(pool);
+                BenchmarkCounters counters;
+                auto body = benchmark_case.setup(size, counters);
+
+                // One untimed pass fills plan and window caches and faults in the buffers.
+                body();
+                size_t iterations = 0;
+                double elapsed = 0.0;
+                auto start = Clock::now();
+                do {
+                    body();
+                    ++iterations;
+                    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+                } while (elapsed < options.min_time);
+
+                BenchmarkResult result;
+                result.name = benchmark_case.name + "/" + std::to_string(size) + "/threads:" + std::to_string(pool.size());
+                result.size = size;
+                result.threads = pool.size();
+                result.iterations = iterations;
+                result.seconds_per_iteration = elapsed / iterations;
+                result.samples_per_second = counters.samples / result.seconds_per_iteration;
+                result.gflops = counters.flops / result.seconds_per_iteration * 1e-9;
+                result.bytes_per_second = counters.bytes / result.seconds_per_iteration;
+                results.push_back(result);
+                if (on_result) on_result(result);
+            }
+        }
+    }
+    return results;
+}
+
+std::string Benchmark::toJSON(const std::vector<BenchmarkResult>& results) {
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    std::ostringstream json;
+    json.precision(9);
+    json << "{\n  \"context\": {\"date\": \"" << date << "\", \"num_cpus\": " << std::thread::hardware_concurrency()
+         << ", \"simd\": \"" << simdLevelName(SIMDKernels::active()) << "\"},\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        json << "    {\"name\": \"" << r.name << "\", \"size\": " << r.size << ", \"threads\": " << r.threads
+             << ", \"iterations\": " << r.iterations << ", \"real_time_ns\": " << r.seconds_per_iteration * 1e9
+             << ", \"items_per_second\": " << r.samples_per_second << ", \"gflops\": " << r.gflops
+             << ", \"bytes_per_second\": " << r.bytes_per_second << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    return json.str();
+}
+
+bool Benchmark::saveJSON(const std::vector<BenchmarkResult>& results, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) return false;
+    file << toJSON(results);
+    return static_cast<bool>(file);
+}
+
+std::vector<BenchmarkResult> Benchmark::loadJSON(const std::string& filename) {
+    std::vector<BenchmarkResult> results;
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line)) {
+        BenchmarkResult result;
+        result.name = stringField(line, "name");
+        if (result.name.empty()) continue;
+        result.size = static_cast<size_t>(numberField(line, "size"));
+        result.threads = static_cast<size_t>(numberField(line, "threads"));
+        result.iterations = static_cast<size_t>(numberField(line, "iterations"));
+        result.seconds_per_iteration = numberField(line, "real_time_ns") * 1e-9;
+        result.samples_per_second = numberField(line, "items_per_second");
+        result.gflops = numberField(line, "gflops");
+        result.bytes_per_second = numberField(line, "bytes_per_second");
+        results.push_back(result);
+    }
+    return results;
+}
+
+std::vector<BenchmarkComparison> Benchmark::compare(const std::vector<BenchmarkResult>& baseline,
+                                                    const std::vector<BenchmarkResult>& results, double tolerance) {
+    std::vector<BenchmarkComparison> comparisons;
+    for (const auto& result : results) {
+        for (const auto& old : baseline) {
+            if (old.name != result.name) continue;
+            comparisons.push_back({result.name, old.samples_per_second, result.samples_per_second,
+                                   result.samples_per_second < old.samples_per_second * (1.0 - tolerance)});
+            break;
+        }
+    }
+    return comparisons;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <functional>
+#include <cstddef>
+
+namespace RadarToolkit {
+
+// Work done by one iteration of a benchmark body; rates are derived from these and the measured time.
+struct BenchmarkCounters {
+    double samples = 0.0;
+    double flops = 0.0;
+    double bytes = 0.0;
+};
+
+// setup() runs once per (size, thread count), outside the timed region, fills in the per-iteration
+// counters and returns the body to time. Sizes outside [min_size, max_size] are skipped.
+struct BenchmarkCase {
+    std::string name;
+    std::function<std::function<void()>(size_t size, BenchmarkCounters& counters)> setup;
+    size_t min_size = 0;
+    size_t max_size = ~size_t{0};
+    bool threaded = false;
+};
+
+struct BenchmarkOptions {
+    size_t min_size = 1 << 10;
+    size_t max_size = 1 << 24;
+    size_t size_multiplier = 4;
+    // Thread counts swept for threaded cases; unthreaded cases run once on one thread.
+    std::vector<size_t> threads = {1};
+    double min_time = 0.25;
+    std::string filter;
+};
+
+struct BenchmarkResult {
+    std::string name;
+    size_t size = 0;
+    size_t threads = 1;
+    size_t iterations = 0;
+    double seconds_per_iteration = 0.0;
+    double samples_per_second = 0.0;
+    double gflops = 0.0;
+    double bytes_per_second = 0.0;
+};
+
+// A change of more than the tolerance in samples/s against the baseline run of the same name.
+struct BenchmarkComparison {
+    std::string name;
+    double baseline_samples_per_second = 0.0;
+    double samples_per_second = 0.0;
+    bool regression = false;
+};
+
+class Benchmark {
+public:
+    // generateChirp, addNoise, matchedFilter (direct and FFT), cfarDetection, fft, rangeDopplerMap and
+    // FileIO load/save, for float and double samples.
+    static std::vector<BenchmarkCase> standardSuite();
+
+    static std::vector<BenchmarkResult> run(const std::vector<BenchmarkCase>& cases, const BenchmarkOptions& options,
+                                            const std::function<void(const BenchmarkResult&)>& on_result = {});
+
+    // Results are written one benchmark object per line, which is also what loadJSON expects.
+    static std::string toJSON(const std::vector<BenchmarkResult>& results);
+    static bool saveJSON(const std::vector<BenchmarkResult>& results, const std::string& filename);
+    static std::vector<BenchmarkResult> loadJSON(const std::string& filename);
+
+    static std::vector<BenchmarkComparison> compare(const std::vector<BenchmarkResult>& baseline,
+                                                    const std::vector<BenchmarkResult>& results, double tolerance);
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "src/benchmark.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <algorithm>
+
+// radar_benchmark [--filter S] [--min-size N] [--max-size N] [--threads 1,2,4] [--min-time SEC]
+//                 [--json out.json] [--baseline old.json] [--tolerance 0.1]
+int main(int argc, char* argv[]) {
+    using namespace RadarToolkit;
+    BenchmarkOptions options;
+    size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (hardware_threads > 1) options.threads.push_back(hardware_threads);
+    std::string json_file, baseline_file;
+    double tolerance = 0.10;
+
+    auto value = [&](const std::string& flag) -> const char* {
+        auto it = std::find(argv + 1, argv + argc, flag);
+        return it + 1 < argv + argc ? *(it + 1) : nullptr;
+    };
+    if (auto v = value("--filter")) options.filter = v;
+    if (auto v = value("--min-size")) options.min_size = std::stoull(v);
+    if (auto v = value("--max-size")) options.max_size = std::stoull(v);
+    if (auto v = value("--min-time")) options.min_time = std::stod(v);
+    if (auto v = value("--json")) json_file = v;
+    if (auto v = value("--baseline")) baseline_file = v;
+    if (auto v = value("--tolerance")) tolerance = std::stod(v);
+    if (auto v = value("--threads")) {
+        options.threads.clear();
+        std::stringstream list(v);
+        for (std::string item; std::getline(list, item, ',');) options.threads.push_back(std::stoull(item));
+    }
+
+    std::cout << std::left << std::setw(44) << "Benchmark" << std::right << std::setw(14) << "Time"
+              << std::setw(12) << "Iterations" << std::setw(16) << "Msamples/s" << std::setw(10) << "GFLOP/s"
+              << std::setw(10) << "GB/s" << "\n";
+    auto results = Benchmark::run(Benchmark::standardSuite(), options, [](const BenchmarkResult& r) {
+        std::cout << std::left << std::setw(44) << r.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(11) << r.seconds_per_iteration * 1e6 << " us" << std::setw(12) << r.iterations
+                  << std::setw(16) << r.samples_per_second * 1e-6 << std::setprecision(2) << std::setw(10) << r.gflops
+                  << std::setw(10) << r.bytes_per_second * 1e-9 << std::endl;
+    });
+
+    if (!json_file.empty() && !Benchmark::saveJSON(results, json_file)) {
+        std::cerr << "Failed to write " << json_file << "\n";
+        return 1;
+    }
+
+    if (baseline_file.empty()) return 0;
+    auto baseline = Benchmark::loadJSON(baseline_file);
+    if (baseline.empty()) {
+        std::cerr << "No results in baseline " << baseline_file << "\n";
+        return 1;
+    }
+    size_t regressions = 0;
+    std::cout << "\nComparison against " << baseline_file << ":\n";
+    for (const auto& c : Benchmark::compare(baseline, results, tolerance)) {
+        std::cout << std::left << std::setw(44) << c.name << std::right << std::setprecision(2)
+                  << std::setw(10) << c.samples_per_second / c.baseline_samples_per_second << "x"
+                  << (c.regression ? "  REGRESSION" : "") << "\n";
+        regressions += c.regression;
+    }
+    return regressions ? 2 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,239 @@
+#include "clutter_model.h"
+#include "fft_plan.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <tuple>
+
+namespace RadarToolkit {
+
+// Range cells generated together; keeps the slow-time scratch in cache while writing strided columns.
+constexpr size_t CELL_BLOCK = 16;
+// Samples of a single signal drawn together: one call per block fills each of the speckle, normal and uniform
+// buffers, which stay in cache.
+constexpr size_t SAMPLE_BLOCK = 1024;
+
+template <typename T>
+static double meanPower(std::span<const std::complex<T>> signal) {
+    return std::accumulate(signal.begin(), signal.end(), 0.0,
+                           [](double sum, const auto& s) { return sum + static_cast<double>(std::norm(s)); }) / signal.size();
+}
+
+// Inverse standard normal CDF (Acklam's rational approximation, relative error below 1.2e-9).
+static double inverseNormalCDF(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    if (p < 0.02425) {
+        double q = std::sqrt(-2.0 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    if (p > 1.0 - 0.02425) return -inverseNormalCDF(1.0 - p);
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+// Gamma(shape, 1/shape) variate (unit mean) by Marsaglia-Tsang, drawing from its own stream.
+static double unitMeanGamma(double shape, const RandomStream& rng) {
+    RandomStream normals = rng.split(0);
+    uint64_t uniform_position = 0;
+    uint64_t normal_position = 0;
+    auto uniform = [&] { double u; rng.fillUniform<double>({&u, 1}, uniform_position++); return u; };
+
+    double alpha = shape < 1.0 ? shape + 1.0 : shape;
+    double d = alpha - 1.0 / 3.0;
+    double c = 1.0 / std::sqrt(9.0 * d);
+    double g;
+    while (true) {
+        double x;
+        normals.fillGaussian<double>({&x, 1}, 1.0, normal_position++);
+        double v = 1.0 + c * x;
+        if (v <= 0.0) continue;
+        v = v * v * v;
+        if (std::log(uniform()) < 0.5 * x * x + d - d * v + d * std::log(v)) {
+            g = d * v;
+            break;
+        }
+    }
+    if (shape < 1.0) g *= std::pow(uniform(), 1.0 / shape);
+    return g / shape;
+}
+
+// Unit-mean gamma textures for the samples at positions first.. of a signal, with the law of unitMeanGamma.
+// Each sample's first Marsaglia-Tsang attempt uses batched draws at its own position; the few attempts that are
+// rejected are redrawn by unitMeanGamma on a stream of their own. scratch holds 3 * out.size() values.
+static void unitMeanGammas(double shape, const RandomStream& rng, uint64_t first, std::span<double> out,
+                           std::span<double> scratch) {
+    size_t n = out.size();
+    std::span<double> normals = scratch.first(n), uniforms = scratch.subspan(n, n), boosts = scratch.subspan(2 * n, n);
+    rng.split(0).fillGaussian<double>(normals, 1.0, first);
+    rng.split(1).fillUniform<double>(uniforms, first);
+    if (shape < 1.0) rng.split(2).fillUniform<double>(boosts, first);
+    RandomStream retries = rng.split(3);
+
+    double alpha = shape < 1.0 ? shape + 1.0 : shape;
+    double d = alpha - 1.0 / 3.0;
+    double c = 1.0 / std::sqrt(9.0 * d);
+    for (size_t i = 0; i < n; ++i) {
+        double x = normals[i];
+        double v = 1.0 + c * x;
+        v = v * v * v;
+        if (v <= 0.0 || std::log(uniforms[i]) >= 0.5 * x * x + d - d * v + d * std::log(v)) {
+            out[i] = unitMeanGamma(shape, retries.split(first + i));
+            continue;
+        }
+        double g = d * v;
+        if (shape < 1.0) g *= std::pow(boosts[i], 1.0 / shape);
+        out[i] = g / shape;
+    }
+}
+
+// Remaps unit-power complex Gaussian samples to the model's amplitude law, keeping their phase.
+template <typename T>
+static void shapeAmplitude(std::span<std::complex<T>> samples, const ClutterModel& model) {
+    if (model.amplitude == ClutterAmplitude::Weibull) {
+        double k = std::max(model.shape, 0.1);
+        double scale = 1.0 / std::sqrt(std::tgamma(1.0 + 2.0 / k));
+        for (auto& s : samples) {
+            double power = std::norm(s);
+            if (power == 0.0) continue;
+            // |z|^2 is unit exponential, so |z|^(2/k) is Weibull with shape k.
+            double amplitude = scale * std::pow(power, 1.0 / k);
+            s *= static_cast<T>(amplitude / std::sqrt(power));
+        }
+    } else if (model.amplitude == ClutterAmplitude::LogNormal) {
+        double sigma = model.shape;
+        double scale = std::exp(-sigma * sigma);
+        for (auto& s : samples) {
+            double power = std::norm(s);
+            if (power == 0.0) continue;
+            double u = std::clamp(-std::expm1(-power), 1e-300, 1.0 - 1e-16);
+            double amplitude = scale * std::exp(sigma * inverseNormalCDF(u));
+            s *= static_cast<T>(amplitude / std::sqrt(power));
+        }
+    }
+}
+
+template <typename T>
+std::shared_ptr<const std::vector<T>> BasicClutterGenerator<T>::shapingFilter(const ClutterModel& model,
+                                                                              size_t num_pulses, double prf) {
+    using Key = std::tuple<int, size_t, double, double, double>;
+    static std::mutex mutex;
+    static std::map<Key, std::shared_ptr<const std::vector<T>>> cache;
+
+    Key key{static_cast<int>(model.spectrum), num_pulses, model.doppler_center / prf, model.doppler_spread / prf,
+            model.spectrum_exponent};
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second;
+
+    std::vector<T> response(num_pulses, T(1));
+    double spread = std::max(model.doppler_spread, 1e-12 * prf);
+    for (size_t k = 0; k < num_pulses; ++k) {
+        double offset = std::remainder(k * prf / num_pulses - model.doppler_center, prf);
+        double density = model.spectrum == ClutterSpectrum::Gaussian
+            ? std::exp(-0.5 * offset * offset / (spread * spread))
+            : 1.0 / (1.0 + std::pow(std::abs(offset) / spread, model.spectrum_exponent));
+        response[k] = static_cast<T>(std::sqrt(density));
+    }
+    double mean_square = 0.0;
+    for (T h : response) mean_square += static_cast<double>(h) * h;
+    mean_square /= num_pulses;
+    if (mean_square > 0.0) {
+        for (T& h : response) h = static_cast<T>(h / std::sqrt(mean_square));
+    }
+    return cache.emplace(key, std::make_shared<const std::vector<T>>(std::move(response))).first->second;
+}
+
+template <typename T>
+void BasicClutterGenerator<T>::addClutter(BasicPulseMatrix<T>& cpi, double cnr_db, const ClutterModel& model,
+                                          double prf, const RandomStream& rng) {
+    if (cpi.empty()) return;
+    size_t num_pulses = cpi.numPulses();
+    size_t num_cells = cpi.numSamples();
+    T stddev = static_cast<T>(std::sqrt(meanPower<T>(cpi.samples()) * std::pow(10.0, cnr_db / 10.0)));
+
+    std::shared_ptr<const std::vector<T>> response;
+    std::shared_ptr<const BasicFFTPlan<T>> plan;
+    if (model.spectrum != ClutterSpectrum::White && num_pulses > 1) {
+        response = shapingFilter(model, num_pulses, prf);
+        plan = BasicFFTPlan<T>::get(num_pulses);
+    }
+    RandomStream speckle = rng.split(0);
+    RandomStream texture = rng.split(1);
+
+    ThreadPool::shared().parallelFor((num_cells + CELL_BLOCK - 1) / CELL_BLOCK, [&](size_t begin, size_t end) {
+        std::vector<std::complex<T>> slow_time(num_pulses);
+        for (size_t cell = begin * CELL_BLOCK; cell < std::min(end * CELL_BLOCK, num_cells); ++cell) {
+            std::fill(slow_time.begin(), slow_time.end(), std::complex<T>(0));
+            speckle.addComplexGaussian<T>(slow_time, static_cast<T>(std::sqrt(0.5)), cell * num_pulses);
+            if (plan) {
+                plan->forward(slow_time);
+                for (size_t k = 0; k < num_pulses; ++k) slow_time[k] *= (*response)[k];
+                plan->inverse(slow_time);
+                for (auto& s : slow_time) s /= static_cast<T>(num_pulses);
+            }
+
+            T gain = stddev;
+            if (model.amplitude == ClutterAmplitude::KDistributed) {
+                gain *= static_cast<T>(std::sqrt(unitMeanGamma(std::max(model.shape, 1e-3), texture.split(cell))));
+            } else {
+                shapeAmplitude<T>(slow_time, model);
+            }
+            for (size_t p = 0; p < num_pulses; ++p) cpi(p, cell) += gain * slow_time[p];
+        }
+    });
+}
+
+template <typename T>
+void BasicClutterGenerator<T>::addClutter(BasicPulseMatrix<T>& cpi, double cnr_db, const ClutterModel& model, double prf) {
+    addClutter(cpi, cnr_db, model, prf, RandomStream::next());
+}
+
+template <typename T>
+void BasicClutterGenerator<T>::addClutter(std::span<std::complex<T>> signal, double cnr_db, const ClutterModel& model,
+                                          const RandomStream& rng) {
+    if (signal.empty()) return;
+    T stddev = static_cast<T>(std::sqrt(meanPower<T>(signal) * std::pow(10.0, cnr_db / 10.0)));
+    RandomStream speckle = rng.split(0);
+    RandomStream texture = rng.split(1);
+
+    ThreadPool::shared().parallelFor(signal.size(), [&](size_t begin, size_t end) {
+        // Per-thread scratch, so steady-state calls do not allocate.
+        thread_local std::vector<std::complex<T>> samples;
+        thread_local std::vector<double> textures, draws;
+        samples.resize(SAMPLE_BLOCK);
+        textures.resize(SAMPLE_BLOCK);
+        draws.resize(3 * SAMPLE_BLOCK);
+        for (size_t start = begin; start < end; start += SAMPLE_BLOCK) {
+            std::span<std::complex<T>> block(samples.data(), std::min(SAMPLE_BLOCK, end - start));
+            std::fill(block.begin(), block.end(), std::complex<T>(0));
+            speckle.addComplexGaussian<T>(block, static_cast<T>(std::sqrt(0.5)), start);
+            if (model.amplitude == ClutterAmplitude::KDistributed) {
+                std::span<double> texture_block(textures.data(), block.size());
+                unitMeanGammas(std::max(model.shape, 1e-3), texture, start, texture_block,
+                               std::span<double>(draws).first(3 * block.size()));
+                for (size_t i = 0; i < block.size(); ++i) block[i] *= static_cast<T>(std::sqrt(texture_block[i]));
+            } else {
+                shapeAmplitude<T>(block, model);
+            }
+            for (size_t i = 0; i < block.size(); ++i) signal[start + i] += stddev * block[i];
+        }
+    }, 16384);
+}
+
+template class BasicClutterGenerator<float>;
+template class BasicClutterGenerator<double>;
+
+}
\ No newline at end of file
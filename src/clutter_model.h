@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include <complex>
+#include <span>
+#include <memory>
+#include "pulse_matrix.h"
+#include "random.h"
+
+namespace RadarToolkit {
+
+enum class ClutterAmplitude { Rayleigh, KDistributed, Weibull, LogNormal };
+enum class ClutterSpectrum { White, Gaussian, PowerLaw };
+
+struct ClutterModel {
+    ClutterAmplitude amplitude = ClutterAmplitude::Rayleigh;
+    // K: texture shape nu (smaller is spikier); Weibull: shape k; log-normal: sigma of ln(amplitude).
+    double shape = 1.0;
+    ClutterSpectrum spectrum = ClutterSpectrum::White;
+    double doppler_center = 0.0;   // Hz
+    double doppler_spread = 0.0;   // Hz: Gaussian standard deviation or power-law corner frequency
+    double spectrum_exponent = 3.0;
+};
+
+// Clutter with non-Rayleigh amplitude statistics and a Doppler spectrum shaped across the CPI. Each range
+// cell gets a slow-time Gaussian sequence filtered in the frequency domain; K clutter modulates it with a
+// per-cell gamma texture, Weibull and log-normal clutter remap its amplitude sample by sample.
+template <typename T>
+class BasicClutterGenerator {
+public:
+    // Adds clutter with mean power cnr * mean power of the CPI, correlated along slow time at the given PRF.
+    static void addClutter(BasicPulseMatrix<T>& cpi, double cnr_db, const ClutterModel& model, double prf,
+                           const RandomStream& rng);
+    static void addClutter(BasicPulseMatrix<T>& cpi, double cnr_db, const ClutterModel& model, double prf);
+    // Single pulse: amplitude statistics only, samples are independent.
+    static void addClutter(std::span<std::complex<T>> signal, double cnr_db, const ClutterModel& model,
+                           const RandomStream& rng);
+
+    // Unit-power amplitude response sqrt(S(f)) over num_pulses Doppler bins; cached per spectrum and size.
+    static std::shared_ptr<const std::vector<T>> shapingFilter(const ClutterModel& model, size_t num_pulses, double prf);
+};
+
+using ClutterGenerator = BasicClutterGenerator<double>;
+using ClutterGeneratorF = BasicClutterGenerator<float>;
+
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "fft_plan.h"
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+#include <stdexcept>
+
+namespace RadarToolkit {
+
+constexpr double PI = 3.14159265358979323846;
+
+template <typename T>
+size_t BasicFFTPlan<T>::nextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+template <typename T>
+BasicFFTPlan<T>::BasicFFTPlan(size_t size) : n(size) {
+    if (n == 0) throw std::invalid_argument("FFTPlan: size must be non-zero");
+
+    if ((n & (n - 1)) == 0) {
+        while ((size_t{1} << log2n) < n) ++log2n;
+
+        bit_reverse.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            size_t r = 0;
+            for (unsigned b = 0; b < log2n; ++b) r |= ((i >> b) & 1) << (log2n - 1 - b);
+            bit_reverse[i] = r;
+        }
+
+        // Each twiddle is evaluated directly rather than by recurrence, so the table is
+        // accurate to the last ulp regardless of size.
+        twiddles.resize(n);
+        for (size_t k = 0; k < n; ++k) {
+            double angle = -2.0 * PI * static_cast<double>(k) / static_cast<double>(n);
+            twiddles[k] = {static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle))};
+        }
+        return;
+    }
+
+    // Bluestein: X[k] = w[k] * sum_j (x[j] w[j]) conj(w[k - j]), with w[j] = exp(-i pi j^2 / n).
+    size_t m = nextPowerOfTwo(2 * n - 1);
+    sub_plan = get(m);
+
+    chirp.resize(n);
+    for (size_t j = 0; j < n; ++j) {
+        size_t j2 = (j * j) % (2 * n);
+        double angle = -PI * static_cast<double>(j2) / static_cast<double>(n);
+        chirp[j] = {static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle))};
+    }
+
+    chirp_spectrum.assign(m, T(0));
+    chirp_spectrum[0] = std::conj(chirp[0]);
+    for (size_t j = 1; j < n; ++j) {
+        chirp_spectrum[j] = std::conj(chirp[j]);
+        chirp_spectrum[m - j] = std::conj(chirp[j]);
+    }
+    sub_plan->forward(chirp_spectrum);
+}
+
+template <typename T>
+std::shared_ptr<const BasicFFTPlan<T>> BasicFFTPlan<T>::get(size_t size) {
+    static std::mutex mutex;
+    static std::unordered_map<size_t, std::shared_ptr<const BasicFFTPlan>> cache;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = cache.find(size);
+        if (it != cache.end()) return it->second;
+    }
+    // Built outside the lock: a Bluestein plan fetches its power-of-two sub-plan from here.
+    auto plan = std::make_shared<const BasicFFTPlan>(size);
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.emplace(size, std::move(plan)).first->second;
+}
+
+template <typename T>
+void BasicFFTPlan<T>::forward(std::span<std::complex<T>> data) const {
+    if (data.size() != n) throw std::invalid_argument("FFTPlan: buffer size does not match plan");
+    if (sub_plan) bluestein(data.data(), false);
+    else radix4(data.data(), false);
+}
+
+template <typename T>
+void BasicFFTPlan<T>::inverse(std::span<std::complex<T>> data) const {
+    if (data.size() != n) throw std::invalid_argument("FFTPlan: buffer size does not match plan");
+    if (sub_plan) bluestein(data.data(), true);
+    else radix4(data.data(), true);
+}
+
+template <typename T>
+void BasicFFTPlan<T>::radix4(std::complex<T>* data, bool inverse) const {
+    if (n == 1) return;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (i < bit_reverse[i]) std::swap(data[i], data[bit_reverse[i]]);
+    }
+
+    size_t h = 1;
+    if (log2n & 1) {
+        for (size_t i = 0; i < n; i += 2) {
+            std::complex<T> t = data[i + 1];
+            data[i + 1] = data[i] - t;
+            data[i] += t;
+        }
+        h = 2;
+    }
+
+    // In bit-reversed order a block of 4h holds the size-h transforms of residues 0, 2, 1, 3 (mod 4).
+    const std::complex<T> rot = inverse ? std::complex<T>(0, 1) : std::complex<T>(0, -1);
+    for (; h < n; h *= 4) {
+        size_t stride = n / (4 * h);
+        for (size_t start = 0; start < n; start += 4 * h) {
+            for (size_t j = 0; j < h; ++j) {
+                std::complex<T> w1 = twiddles[j * stride];
+                std::complex<T> w2 = twiddles[2 * j * stride];
+                std::complex<T> w3 = twiddles[3 * j * stride];
+                if (inverse) {
+                    w1 = std::conj(w1);
+                    w2 = std::conj(w2);
+                    w3 = std::conj(w3);
+                }
+
+                std::complex<T>* p = data + start + j;
+                std::complex<T> a = p[0];
+                std::complex<T> b = w2 * p[h];
+                std::complex<T> c = w1 * p[2 * h];
+                std::complex<T> d = w3 * p[3 * h];
+
+                std::complex<T> s0 = a + b, s1 = a - b;
+                std::complex<T> s2 = c + d, s3 = rot * (c - d);
+                p[0] = s0 + s2;
+                p[h] = s1 + s3;
+                p[2 * h] = s0 - s2;
+                p[3 * h] = s1 - s3;
+            }
+        }
+    }
+}
+
+template <typename T>
+void BasicFFTPlan<T>::bluestein(std::complex<T>* data, bool inverse) const {
+    // The inverse transform is conj(forward(conj(x))).
+    size_t m = sub_plan->size();
+    // Per-thread scratch, so steady-state transforms do not allocate.
+    thread_local std::vector<std::complex<T>> work;
+    work.assign(m, T(0));
+    for (size_t j = 0; j < n; ++j) {
+        std::complex<T> x = inverse ? std::conj(data[j]) : data[j];
+        work[j] = x * chirp[j];
+    }
+
+    sub_plan->forward(work);
+    for (size_t k = 0; k < m; ++k) work[k] *= chirp_spectrum[k];
+    sub_plan->inverse(work);
+
+    T scale = T(1) / static_cast<T>(m);
+    for (size_t k = 0; k < n; ++k) {
+        std::complex<T> y = work[k] * chirp[k] * scale;
+        data[k] = inverse ? std::conj(y) : y;
+    }
+}
+
+template class BasicFFTPlan<float>;
+template class BasicFFTPlan<double>;
+
+}
\ No newline at end of file
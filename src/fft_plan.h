@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+#include <complex>
+#include <memory>
+#include <span>
+
+namespace RadarToolkit {
+
+// Precomputed FFT of a fixed length. Powers of two run as an iterative in-place
+// radix-4 (plus one radix-2 pass for odd log2 sizes); any other length goes through
+// Bluestein's chirp-z algorithm on a power-of-two sub-plan. Plans are immutable, so
+// one instance can be shared by any number of threads. Instantiated for float and double.
+template <typename T>
+class BasicFFTPlan {
+public:
+    explicit BasicFFTPlan(size_t size);
+
+    static std::shared_ptr<const BasicFFTPlan> get(size_t size);
+    static size_t nextPowerOfTwo(size_t n);
+
+    size_t size() const { return n; }
+    void forward(std::span<std::complex<T>> data) const;
+    // Unnormalized: inverse(forward(x)) == size() * x.
+    void inverse(std::span<std::complex<T>> data) const;
+
+private:
+    size_t n;
+    unsigned log2n = 0;
+    std::vector<size_t> bit_reverse;
+    std::vector<std::complex<T>> twiddles;
+
+    std::vector<std::complex<T>> chirp;
+    std::vector<std::complex<T>> chirp_spectrum;
+    std::shared_ptr<const BasicFFTPlan> sub_plan;
+
+    void radix4(std::complex<T>* data, bool inverse) const;
+    void bluestein(std::complex<T>* data, bool inverse) const;
+};
+
+using FFTPlan = BasicFFTPlan<double>;
+using FFTPlanF = BasicFFTPlan<float>;
+
+}
\ No newline at end of file
@@ -1,10 +1,224 @@
 #include "file_io.h"
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace RadarToolkit {
 
-bool FileIO::saveSignal(const std::vector<std::complex<double>>& signal, const std::string& filename) {
+bool IQFileHeader::valid() const {
+    static const IQFileHeader reference;
+    return std::memcmp(magic, reference.magic, sizeof(magic)) == 0 && version == 1 && bytesPerSample() != 0;
+}
+
+size_t IQFileHeader::bytesPerSample() const {
+    switch (sample_format) {
+        case SampleFormat::ComplexInt16: return 2 * sizeof(int16_t);
+        case SampleFormat::ComplexFloat32: return 2 * sizeof(float);
+        case SampleFormat::ComplexFloat64: return 2 * sizeof(double);
+    }
+    return 0;
+}
+
+template <typename S, typename T>
+static void decodeAs(const uint8_t* src, std::complex<T>* dst, size_t count, T scale) {
+    for (size_t i = 0; i < count; ++i) {
+        S iq[2];
+        std::memcpy(iq, src + i * sizeof(iq), sizeof(iq));
+        dst[i] = {static_cast<T>(iq[0]) * scale, static_cast<T>(iq[1]) * scale};
+    }
+}
+
+template <typename T>
+static void decodeSamples(const uint8_t* src, SampleFormat format, std::complex<T>* dst, size_t count) {
+    switch (format) {
+        case SampleFormat::ComplexInt16: decodeAs<int16_t>(src, dst, count, T(1) / T(32768)); break;
+        case SampleFormat::ComplexFloat32: decodeAs<float>(src, dst, count, T(1)); break;
+        case SampleFormat::ComplexFloat64: decodeAs<double>(src, dst, count, T(1)); break;
+    }
+}
+
+template <typename S, typename T>
+static void encodeAs(const std::complex<T>* src, uint8_t* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        S iq[2];
+        if constexpr (std::is_same_v<S, int16_t>) {
+            for (int c = 0; c < 2; ++c) {
+                double v = std::round((c == 0 ? src[i].real() : src[i].imag()) * 32768.0);
+                iq[c] = static_cast<int16_t>(std::clamp(v, -32768.0, 32767.0));
+            }
+        } else {
+            iq[0] = static_cast<S>(src[i].real());
+            iq[1] = static_cast<S>(src[i].imag());
+        }
+        std::memcpy(dst + i * sizeof(iq), iq, sizeof(iq));
+    }
+}
+
+template <typename T>
+static void encodeSamples(const std::complex<T>* src, SampleFormat format, uint8_t* dst, size_t count) {
+    switch (format) {
+        case SampleFormat::ComplexInt16: encodeAs<int16_t>(src, dst, count); break;
+        case SampleFormat::ComplexFloat32: encodeAs<float>(src, dst, count); break;
+        case SampleFormat::ComplexFloat64: encodeAs<double>(src, dst, count); break;
+    }
+}
+
+MappedIQFile::~MappedIQFile() {
+    close();
+}
+
+bool MappedIQFile::open(const std::string& filename) {
+    close();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(IQFileHeader)) {
+        ::close(fd);
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) return false;
+
+    base = static_cast<const uint8_t*>(mapping);
+    mapped_bytes = info.st_size;
+    if (!header().valid()) {
+        close();
+        return false;
+    }
+    ::madvise(mapping, mapped_bytes, MADV_SEQUENTIAL);
+
+    size_t available = (mapped_bytes - sizeof(IQFileHeader)) / header().bytesPerSample();
+    sample_count = header().num_samples ? std::min<size_t>(header().num_samples, available) : available;
+    return true;
+}
+
+void MappedIQFile::close() {
+    if (base) ::munmap(const_cast<uint8_t*>(base), mapped_bytes);
+    base = nullptr;
+    mapped_bytes = 0;
+    sample_count = 0;
+}
+
+std::span<const int16_t> MappedIQFile::rawIQ16() const {
+    if (!isOpen() || header().sample_format != SampleFormat::ComplexInt16) return {};
+    return {reinterpret_cast<const int16_t*>(payload()), 2 * sample_count};
+}
+
+IQStreamReader::~IQStreamReader() {
+    close();
+}
+
+bool IQStreamReader::open(const std::string& source) {
+    close();
+    if (source == "-") {
+        file = stdin;
+    } else {
+        file = std::fopen(source.c_str(), "rb");
+        owns_file = true;
+    }
+    if (!file || std::fread(&file_header, sizeof(file_header), 1, file) != 1 || !file_header.valid()) {
+        close();
+        return false;
+    }
+    samples_read = 0;
+    read_failed = false;
+    return true;
+}
+
+void IQStreamReader::close() {
+    if (file && owns_file) std::fclose(file);
+    file = nullptr;
+    owns_file = false;
+}
+
+template <typename T>
+size_t IQStreamReader::read(std::span<std::complex<T>> out) {
+    if (!file) return 0;
+    size_t want = out.size();
+    if (file_header.num_samples) want = std::min<uint64_t>(want, file_header.num_samples - samples_read);
+    if (want == 0) return 0;
+
+    size_t got;
+    if (file_header.sample_format == nativeSampleFormat<T>()) {
+        got = std::fread(out.data(), sizeof(std::complex<T>), want, file);
+    } else {
+        size_t bytes_per_sample = file_header.bytesPerSample();
+        scratch.resize(want * bytes_per_sample);
+        got = std::fread(scratch.data(), bytes_per_sample, want, file);
+        decodeSamples(scratch.data(), file_header.sample_format, out.data(), got);
+    }
+    samples_read += got;
+    // A short read is the normal end of a stream of unknown length, unless the stream itself reports an error.
+    if (got < want && (file_header.num_samples || std::ferror(file))) read_failed = true;
+    return got;
+}
+
+IQStreamWriter::~IQStreamWriter() {
+    close();
+}
+
+bool IQStreamWriter::open(const std::string& destination, const IQFileHeader& header) {
+    close();
+    file_header = header;
+    if (destination == "-") {
+        file = stdout;
+    } else {
+        file = std::fopen(destination.c_str(), "wb");
+        owns_file = true;
+    }
+    if (!file || std::fwrite(&file_header, sizeof(file_header), 1, file) != 1) {
+        close();
+        return false;
+    }
+    file_header.num_samples = 0;
+    return true;
+}
+
+bool IQStreamWriter::close() {
+    if (!file) return true;
+    bool ok = std::fflush(file) == 0;
+    if (owns_file) {
+        if (std::fseek(file, 0, SEEK_SET) == 0) {
+            ok = std::fwrite(&file_header, sizeof(file_header), 1, file) == 1 && ok;
+        }
+        ok = std::fclose(file) == 0 && ok;
+    }
+    file = nullptr;
+    owns_file = false;
+    return ok;
+}
+
+template <typename T>
+bool IQStreamWriter::write(std::span<const std::complex<T>> samples) {
+    if (!file) return false;
+    size_t written;
+    if (file_header.sample_format == nativeSampleFormat<T>()) {
+        written = std::fwrite(samples.data(), sizeof(std::complex<T>), samples.size(), file);
+    } else {
+        size_t bytes_per_sample = file_header.bytesPerSample();
+        scratch.resize(samples.size() * bytes_per_sample);
+        encodeSamples(samples.data(), file_header.sample_format, scratch.data(), samples.size());
+        written = std::fwrite(scratch.data(), bytes_per_sample, samples.size(), file);
+    }
+    file_header.num_samples += written;
+    return written == samples.size();
+}
+
+template size_t IQStreamReader::read<float>(std::span<std::complex<float>>);
+template size_t IQStreamReader::read<double>(std::span<std::complex<double>>);
+template bool IQStreamWriter::write<float>(std::span<const std::complex<float>>);
+template bool IQStreamWriter::write<double>(std::span<const std::complex<double>>);
+
+template <typename T>
+bool BasicFileIO<T>::saveSignal(std::span<const std::complex<T>> signal, const std::string& filename) {
     std::ofstream file(filename);
     if (!file.is_open()) return false;
     for (const auto& sample : signal) {
@@ -13,15 +227,16 @@ bool FileIO::saveSignal(const std::vector<std::complex<double>>& signal, const s
     return true;
 }
 
-std::vector<std::complex<double>> FileIO::loadSignal(const std::string& filename) {
-    std::vector<std::complex<double>> signal;
+template <typename T>
+std::vector<std::complex<T>> BasicFileIO<T>::loadSignal(const std::string& filename) {
+    std::vector<std::complex<T>> signal;
     std::ifstream file(filename);
     if (!file.is_open()) return signal;
 
     std::string line;
     while (std::getline(file, line)) {
         std::stringstream ss(line);
-        double real, imag;
+        T real, imag;
         char comma;
         ss >> real >> comma >> imag;
         signal.emplace_back(real, imag);
@@ -29,4 +244,84 @@ std::vector<std::complex<double>> FileIO::loadSignal(const std::string& filename
     return signal;
 }
 
+template <typename T>
+bool BasicFileIO<T>::savePulses(const BasicPulseMatrix<T>& pulses, const std::string& filename) {
+    return saveSignal(pulses.samples(), filename);
+}
+
+template <typename T>
+bool BasicFileIO<T>::loadPulses(const std::string& filename, size_t num_samples, BasicPulseMatrix<T>& pulses) {
+    auto samples = loadSignal(filename);
+    if (samples.empty() || num_samples == 0 || samples.size() % num_samples != 0) return false;
+    pulses.resize(samples.size() / num_samples, num_samples);
+    std::copy(samples.begin(), samples.end(), pulses.data());
+    return true;
+}
+
+template <typename T>
+std::vector<std::complex<T>> BasicFileIO<T>::convertIQ16(std::span<const int16_t> interleaved) {
+    constexpr T scale = T(1) / T(32768);
+    std::vector<std::complex<T>> signal(interleaved.size() / 2);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = {interleaved[2 * i] * scale, interleaved[2 * i + 1] * scale};
+    }
+    return signal;
+}
+
+template <typename T>
+std::vector<std::complex<T>> BasicFileIO<T>::loadIQ16(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return {};
+    std::streamsize bytes = file.tellg();
+    file.seekg(0);
+    std::vector<int16_t> raw(static_cast<size_t>(bytes) / sizeof(int16_t));
+    if (!file.read(reinterpret_cast<char*>(raw.data()), raw.size() * sizeof(int16_t))) return {};
+    return convertIQ16(raw);
+}
+
+template <typename T>
+bool BasicFileIO<T>::saveBinary(std::span<const std::complex<T>> signal, const std::string& filename, IQFileHeader metadata) {
+    metadata.sample_format = nativeSampleFormat<T>();
+    metadata.num_samples = signal.size();
+    if (metadata.num_pulses == 0) {
+        metadata.num_pulses = 1;
+        metadata.samples_per_pulse = signal.size();
+    }
+
+    IQStreamWriter writer;
+    if (!writer.open(filename, metadata)) return false;
+    bool ok = writer.write(signal);
+    return writer.close() && ok;
+}
+
+template <typename T>
+bool BasicFileIO<T>::saveBinary(const BasicPulseMatrix<T>& pulses, const std::string& filename, IQFileHeader metadata) {
+    metadata.num_pulses = pulses.numPulses();
+    metadata.samples_per_pulse = pulses.numSamples();
+    if (metadata.pulses_per_cpi == 0) metadata.pulses_per_cpi = pulses.numPulses();
+    return saveBinary(pulses.samples(), filename, metadata);
+}
+
+template <typename T>
+bool BasicFileIO<T>::loadBinary(const std::string& filename, BasicPulseMatrix<T>& pulses, IQFileHeader* metadata) {
+    MappedIQFile mapped;
+    if (!mapped.open(filename)) return false;
+    const IQFileHeader& header = mapped.header();
+    size_t length = header.samples_per_pulse ? header.samples_per_pulse : mapped.numSamples();
+    if (length == 0) return false;
+
+    pulses.resize(mapped.numSamples() / length, length);
+    decodeSamples(mapped.payload(), header.sample_format, pulses.data(), pulses.size());
+    if (metadata) *metadata = header;
+    return true;
+}
+
+template <typename T>
+bool BasicFileIO<T>::isBinaryFile(const std::string& filename) {
+    return filename.ends_with(".iq");
+}
+
+template class BasicFileIO<float>;
+template class BasicFileIO<double>;
+
 }
@@ -2,13 +2,140 @@
 #include <vector>
 #include <complex>
 #include <string>
+#include <span>
+#include <cstdint>
+#include <cstdio>
+#include "pulse_matrix.h"
 
 namespace RadarToolkit {
 
-class FileIO {
+enum class SampleFormat : uint32_t { ComplexInt16 = 1, ComplexFloat32 = 2, ComplexFloat64 = 3 };
+
+template <typename T> constexpr SampleFormat nativeSampleFormat();
+template <> constexpr SampleFormat nativeSampleFormat<float>() { return SampleFormat::ComplexFloat32; }
+template <> constexpr SampleFormat nativeSampleFormat<double>() { return SampleFormat::ComplexFloat64; }
+
+// Fixed 128-byte little-endian header of the binary .iq format; samples follow immediately as
+// interleaved I/Q. num_samples == 0 means "unknown, read to end of stream" (e.g. a pipe).
+struct IQFileHeader {
+    char magic[8] = {'R', 'A', 'D', 'A', 'R', 'I', 'Q', '\0'};
+    uint32_t version = 1;
+    SampleFormat sample_format = SampleFormat::ComplexFloat64;
+    double fs = 0.0;
+    double f0 = 0.0;
+    double bandwidth = 0.0;
+    double prf = 0.0;
+    uint64_t num_samples = 0;
+    uint64_t num_pulses = 0;
+    uint64_t samples_per_pulse = 0;
+    uint64_t pulses_per_cpi = 0;
+    uint64_t cpi_index = 0;
+    uint8_t reserved[40] = {};
+
+    bool valid() const;
+    size_t bytesPerSample() const;
+};
+static_assert(sizeof(IQFileHeader) == 128, "IQFileHeader layout is part of the file format");
+
+// Read-only memory mapping of a .iq file. Sample views point straight into the mapping.
+class MappedIQFile {
+public:
+    MappedIQFile() = default;
+    ~MappedIQFile();
+    MappedIQFile(const MappedIQFile&) = delete;
+    MappedIQFile& operator=(const MappedIQFile&) = delete;
+
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+    const IQFileHeader& header() const { return *reinterpret_cast<const IQFileHeader*>(base); }
+    size_t numSamples() const { return sample_count; }
+
+    // Empty unless the file holds samples of exactly this type.
+    template <typename T>
+    std::span<const std::complex<T>> samples() const {
+        if (!isOpen() || header().sample_format != nativeSampleFormat<T>()) return {};
+        return {reinterpret_cast<const std::complex<T>*>(base + sizeof(IQFileHeader)), sample_count};
+    }
+    // Empty unless the file holds samples of this type and a whole pulse at index.
+    template <typename T>
+    std::span<const std::complex<T>> pulse(size_t index) const {
+        auto all = samples<T>();
+        size_t length = all.empty() ? 0 : header().samples_per_pulse;
+        if (length == 0 || index >= all.size() / length) return {};
+        return all.subspan(index * length, length);
+    }
+    std::span<const int16_t> rawIQ16() const;
+    const uint8_t* payload() const { return base ? base + sizeof(IQFileHeader) : nullptr; }
+
+private:
+    const uint8_t* base = nullptr;
+    size_t mapped_bytes = 0;
+    size_t sample_count = 0;
+};
+
+// Chunked reader for files, pipes or stdin ("-"); converts any stored format to the requested type.
+class IQStreamReader {
 public:
-    static bool saveSignal(const std::vector<std::complex<double>>& signal, const std::string& filename);
-    static std::vector<std::complex<double>> loadSignal(const std::string& filename);
+    IQStreamReader() = default;
+    ~IQStreamReader();
+    IQStreamReader(const IQStreamReader&) = delete;
+    IQStreamReader& operator=(const IQStreamReader&) = delete;
+
+    bool open(const std::string& source);
+    void close();
+    const IQFileHeader& header() const { return file_header; }
+    // Returns the number of samples read; 0 at end of stream.
+    template <typename T> size_t read(std::span<std::complex<T>> out);
+    // True once a read failed, or the stream ended before the sample count its header promised.
+    bool failed() const { return read_failed; }
+
+private:
+    std::FILE* file = nullptr;
+    bool owns_file = false;
+    IQFileHeader file_header;
+    uint64_t samples_read = 0;
+    bool read_failed = false;
+    std::vector<uint8_t> scratch;
 };
 
+// Chunked writer for files, pipes or stdout ("-"). The sample count is patched into the header on
+// close when the destination is seekable.
+class IQStreamWriter {
+public:
+    IQStreamWriter() = default;
+    ~IQStreamWriter();
+    IQStreamWriter(const IQStreamWriter&) = delete;
+    IQStreamWriter& operator=(const IQStreamWriter&) = delete;
+
+    bool open(const std::string& destination, const IQFileHeader& header);
+    bool close();
+    template <typename T> bool write(std::span<const std::complex<T>> samples);
+
+private:
+    std::FILE* file = nullptr;
+    bool owns_file = false;
+    IQFileHeader file_header;
+    std::vector<uint8_t> scratch;
+};
+
+template <typename T>
+class BasicFileIO {
+public:
+    static bool saveSignal(std::span<const std::complex<T>> signal, const std::string& filename);
+    static std::vector<std::complex<T>> loadSignal(const std::string& filename);
+    static bool savePulses(const BasicPulseMatrix<T>& pulses, const std::string& filename);
+    static bool loadPulses(const std::string& filename, size_t num_samples, BasicPulseMatrix<T>& pulses);
+    // Raw interleaved int16 I/Q as delivered by the ADC, scaled to [-1, 1).
+    static std::vector<std::complex<T>> convertIQ16(std::span<const int16_t> interleaved);
+    static std::vector<std::complex<T>> loadIQ16(const std::string& filename);
+    static bool saveBinary(std::span<const std::complex<T>> signal, const std::string& filename, IQFileHeader metadata = {});
+    static bool saveBinary(const BasicPulseMatrix<T>& pulses, const std::string& filename, IQFileHeader metadata = {});
+    static bool loadBinary(const std::string& filename, BasicPulseMatrix<T>& pulses, IQFileHeader* metadata = nullptr);
+    static bool isBinaryFile(const std::string& filename);
+};
+
+using FileIO = BasicFileIO<double>;
+using FileIOF = BasicFileIO<float>;
+
 }
\ No newline at end of file
@@ -1,11 +1,138 @@
 #include "src/radar_cli.h"
+#include "src/metrics.h"
+#include "src/test_suite.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <charconv>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: radar_toolkit [command] [options]\n"
+                 "Commands:\n"
+                 "  (none)          interactive menu\n"
+                 "  run CONFIG      run a processing graph (INI or JSON) or a legacy SNR/CNR batch file\n"
+                 "  plan CONFIG     validate a processing graph and print its fused stage plan\n"
+                 "  stream SOURCE   process a binary .iq stream from a file or stdin (-)\n"
+                 "  test            run the unit tests\n"
+                 "  help            show this message\n"
+                 "Options:\n"
+                 "  --float                 single precision\n"
+                 "  --jobs N                worker threads (0 = all hardware threads)\n"
+                 "  --seed S                master seed\n"
+                 "  --metrics FILE          export stage metrics (.prom for Prometheus text)\n"
+                 "  --metrics-interval SEC  metrics export period (default 1)\n"
+                 "  --batch CONFIG, --stream SOURCE  same as the run and stream commands\n";
+}
+
+// Whole-token numbers only: "2x" or "two" are errors rather than 2 or an exception.
+template <typename V>
+bool parseNumber(const std::string& text, V& value) {
+    const char* end = text.data() + text.size();
+    auto [ptr, error] = std::from_chars(text.data(), end, value);
+    return error == std::errc() && ptr == end && !text.empty();
+}
+
+}
 
 int main(int argc, char* argv[]) {
     RadarToolkit::RadarCLI cli;
-    if (argc > 2 && std::string(argv[1]) == "--batch") {
-        cli.runBatch(argv[2]);
-    } else {
+    // Flags may appear anywhere; every other token is positional: the command, then its operand.
+    std::vector<std::string> positional;
+    std::string metrics_file, batch, stream;
+    double interval = 1.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-" || arg[0] != '-') {
+            positional.push_back(arg);
+            continue;
+        }
+        if (arg == "--float") {
+            cli.setSinglePrecision(true);
+            continue;
+        }
+        bool takes_value = arg == "--jobs" || arg == "--seed" || arg == "--metrics" || arg == "--metrics-interval" ||
+                           arg == "--batch" || arg == "--stream";
+        if (!takes_value) {
+            std::cerr << "Unknown option: " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+        if (i + 1 == argc) {
+            std::cerr << arg << " needs a value\n";
+            printUsage();
+            return 1;
+        }
+        std::string value = argv[++i];
+        bool valid = true;
+        if (arg == "--jobs") {
+            size_t jobs = 0;
+            valid = parseNumber(value, jobs);
+            if (valid) cli.setJobs(jobs);
+        } else if (arg == "--seed") {
+            uint64_t seed = 0;
+            valid = parseNumber(value, seed);
+            if (valid) cli.setSeed(seed);
+        } else if (arg == "--metrics-interval") {
+            valid = parseNumber(value, interval) && interval > 0.0;
+        } else if (arg == "--metrics") {
+            metrics_file = value;
+        } else if (arg == "--batch") {
+            batch = value;
+        } else {
+            stream = value;
+        }
+        if (!valid) {
+            std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    // --metrics FILE rewrites FILE every --metrics-interval seconds (default 1); a .prom file gets Prometheus text.
+    std::unique_ptr<RadarToolkit::MetricsExporter> exporter;
+    if (!metrics_file.empty()) {
+        if (!RadarToolkit::Metrics::enabled) std::cerr << "Metrics are compiled out; rebuild with -DRADAR_ENABLE_METRICS\n";
+        auto format = metrics_file.ends_with(".prom") ? RadarToolkit::MetricsFormat::Prometheus
+                                                      : RadarToolkit::MetricsFormat::JSON;
+        exporter = std::make_unique<RadarToolkit::MetricsExporter>(
+            metrics_file, std::chrono::milliseconds(static_cast<long long>(interval * 1000)), format);
+    }
+
+    std::string command = positional.size() > 0 ? positional[0] : "";
+    std::string operand = positional.size() > 1 ? positional[1] : "";
+    if (command.empty() && !batch.empty()) {
+        command = "run";
+        operand = batch;
+    } else if (command.empty() && !stream.empty()) {
+        command = "stream";
+        operand = stream;
+    }
+
+    if (command.empty()) {
         cli.run();
+        return 0;
+    }
+    if (command == "test") {
+        RadarToolkit::TestSuite::runTests();
+        return 0;
+    }
+    if (command == "help") {
+        printUsage();
+        return 0;
+    }
+    if ((command == "run" || command == "plan" || command == "stream") && operand.empty()) {
+        std::cerr << command << " needs an operand\n";
+        printUsage();
+        return 1;
     }
-    return 0;
+    if (command == "run") return cli.runBatch(operand) ? 0 : 1;
+    if (command == "plan") return cli.printPlan(operand) ? 0 : 1;
+    if (command == "stream") return cli.runStream(operand) ? 0 : 1;
+    std::cerr << "Unknown command: " << command << "\n";
+    printUsage();
+    return 1;
 }
\ No newline at end of file
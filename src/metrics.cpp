@@ -0,0 +1,335 @@
+#include "metrics.h"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <sstream>
+
+#ifdef RADAR_ENABLE_METRICS
+namespace {
+// Plain thread_locals: operator new must not allocate or run constructors to count itself.
+thread_local uint64_t thread_allocations = 0;
+thread_local uint64_t thread_allocated_bytes = 0;
+std::atomic<uint64_t> process_allocations{0};
+
+void* countedAlloc(std::size_t size, std::size_t alignment) {
+    ++thread_allocations;
+    process_allocations.fetch_add(1, std::memory_order_relaxed);
+    thread_allocated_bytes += size;
+    if (size == 0) size = 1;
+    if (alignment <= alignof(std::max_align_t)) return std::malloc(size);
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = countedAlloc(size, 0)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size, 0); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* p = countedAlloc(size, static_cast<std::size_t>(alignment))) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, static_cast<std::size_t>(alignment));
+}
+// GCC pairs operator delete with the library's operator new and flags the free(); both are replaced here.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+#pragma GCC diagnostic pop
+#endif
+
+namespace RadarToolkit {
+
+namespace {
+
+constexpr size_t STAGE_COUNT = static_cast<size_t>(MetricStage::Count);
+
+struct ThreadBlock {
+    struct Stage {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> total_ns{0};
+        std::atomic<uint64_t> max_ns{0};
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> allocated_bytes{0};
+        std::array<std::atomic<uint64_t>, LatencyBuckets::COUNT> histogram{};
+    };
+    std::array<Stage, STAGE_COUNT> stages;
+    std::atomic<bool> in_use{false};
+};
+
+// Blocks outlive their threads (a finished thread's counts still belong in the totals) and are handed to
+// the next new thread. The registry itself is never destroyed, since pool workers may exit during
+// static destruction.
+std::mutex registry_mutex;
+std::vector<std::unique_ptr<ThreadBlock>>& registry() {
+    static auto* blocks = new std::vector<std::unique_ptr<ThreadBlock>>();
+    return *blocks;
+}
+
+struct BlockHolder {
+    ThreadBlock* block = nullptr;
+    ~BlockHolder() {
+        if (block) block->in_use.store(false);
+    }
+};
+thread_local BlockHolder holder;
+thread_local uint32_t active_stages = 0;
+
+ThreadBlock& threadBlock() {
+    if (!holder.block) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (auto& block : registry()) {
+            if (!block->in_use.load()) {
+                holder.block = block.get();
+                break;
+            }
+        }
+        if (!holder.block) {
+            registry().push_back(std::make_unique<ThreadBlock>());
+            holder.block = registry().back().get();
+        }
+        holder.block->in_use.store(true);
+    }
+    return *holder.block;
+}
+
+uint64_t threadAllocatedBytes() {
+#ifdef RADAR_ENABLE_METRICS
+    return thread_allocated_bytes;
+#else
+    return 0;
+#endif
+}
+
+const char* const STAGE_NAMES[STAGE_COUNT] = {
+    "generate_chirp", "generate_barker_code", "generate_pulse_train", "add_noise", "add_clutter",
+    "prepare_reference", "matched_filter", "pulse_compression", "cfar", "cfar_2d", "extraction", "doppler",
+    "range_doppler_map", "fft", "mti", "integration", "batch_scenario"};
+
+}
+
+const char* metricStageName(MetricStage stage) {
+    return stage < MetricStage::Count ? STAGE_NAMES[static_cast<size_t>(stage)] : "unknown";
+}
+
+size_t LatencyBuckets::index(uint64_t nanoseconds) {
+    if (nanoseconds < SUB_BUCKETS) return nanoseconds;
+    unsigned exponent = std::bit_width(nanoseconds) - 1;
+    if (exponent >= MAX_EXPONENT) return COUNT - 1;
+    return (exponent - 3) * SUB_BUCKETS + ((nanoseconds >> (exponent - 4)) & (SUB_BUCKETS - 1));
+}
+
+uint64_t LatencyBuckets::lowerBound(size_t index) {
+    if (index < SUB_BUCKETS) return index;
+    unsigned exponent = static_cast<unsigned>(index / SUB_BUCKETS) + 3;
+    return (SUB_BUCKETS + index % SUB_BUCKETS) << (exponent - 4);
+}
+
+uint64_t LatencyBuckets::upperBound(size_t index) {
+    return index + 1 < COUNT ? lowerBound(index + 1) : lowerBound(index);
+}
+
+uint64_t StageMetrics::quantile(double q) const {
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(q * calls + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < histogram.size(); ++i) {
+        seen += histogram[i];
+        if (seen >= target) return std::min(LatencyBuckets::upperBound(i), max_ns);
+    }
+    return max_ns;
+}
+
+void Metrics::record(MetricStage stage, uint64_t nanoseconds, uint64_t allocations, uint64_t bytes) {
+    auto& counters = threadBlock().stages[static_cast<size_t>(stage)];
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.total_ns.fetch_add(nanoseconds, std::memory_order_relaxed);
+    if (nanoseconds > counters.max_ns.load(std::memory_order_relaxed)) {
+        counters.max_ns.store(nanoseconds, std::memory_order_relaxed);
+    }
+    counters.allocations.fetch_add(allocations, std::memory_order_relaxed);
+    counters.allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    counters.histogram[LatencyBuckets::index(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<StageMetrics> Metrics::snapshot() {
+    std::vector<StageMetrics> stages(STAGE_COUNT);
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (size_t s = 0; s < STAGE_COUNT; ++s) {
+        auto& stage = stages[s];
+        stage.stage = static_cast<MetricStage>(s);
+        stage.histogram.assign(LatencyBuckets::COUNT, 0);
+        for (const auto& block : registry()) {
+            const auto& counters = block->stages[s];
+            stage.calls += counters.calls.load(std::memory_order_relaxed);
+            stage.total_ns += counters.total_ns.load(std::memory_order_relaxed);
+            stage.max_ns = std::max(stage.max_ns, counters.max_ns.load(std::memory_order_relaxed));
+            stage.allocations += counters.allocations.load(std::memory_order_relaxed);
+            stage.allocated_bytes += counters.allocated_bytes.load(std::memory_order_relaxed);
+            for (size_t b = 0; b < LatencyBuckets::COUNT; ++b) {
+                stage.histogram[b] += counters.histogram[b].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    std::erase_if(stages, [](const StageMetrics& stage) { return stage.calls == 0; });
+    return stages;
+}
+
+void Metrics::reset() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto& block : registry()) {
+        for (auto& counters : block->stages) {
+            counters.calls.store(0, std::memory_order_relaxed);
+            counters.total_ns.store(0, std::memory_order_relaxed);
+            counters.max_ns.store(0, std::memory_order_relaxed);
+            counters.allocations.store(0, std::memory_order_relaxed);
+            counters.allocated_bytes.store(0, std::memory_order_relaxed);
+            for (auto& bucket : counters.histogram) bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+uint64_t Metrics::threadAllocations() {
+#ifdef RADAR_ENABLE_METRICS
+    return thread_allocations;
+#else
+    return 0;
+#endif
+}
+
+uint64_t Metrics::processAllocations() {
+#ifdef RADAR_ENABLE_METRICS
+    return process_allocations.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+std::string Metrics::toJSON(const std::vector<StageMetrics>& stages) {
+    std::ostringstream json;
+    json.precision(9);
+    json << "{\n  \"stages\": [\n";
+    for (size_t i = 0; i < stages.size(); ++i) {
+        const auto& s = stages[i];
+        json << "    {\"stage\": \"" << metricStageName(s.stage) << "\", \"calls\": " << s.calls
+             << ", \"total_seconds\": " << s.total_ns * 1e-9 << ", \"mean_us\": " << s.total_ns * 1e-3 / s.calls
+             << ", \"p50_us\": " << s.quantile(0.5) * 1e-3 << ", \"p90_us\": " << s.quantile(0.9) * 1e-3
+             << ", \"p99_us\": " << s.quantile(0.99) * 1e-3 << ", \"max_us\": " << s.max_ns * 1e-3
+             << ", \"allocations\": " << s.allocations << ", \"allocated_bytes\": " << s.allocated_bytes << "}"
+             << (i + 1 < stages.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    return json.str();
+}
+
+std::string Metrics::toPrometheus(const std::vector<StageMetrics>& stages) {
+    std::ostringstream text;
+    text.precision(9);
+    auto family = [&](const char* name, const char* type, const char* help, auto value) {
+        text << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+        for (const auto& s : stages) text << name << "{stage=\"" << metricStageName(s.stage) << "\"} " << value(s) << "\n";
+    };
+    family("radar_stage_calls_total", "counter", "Calls per processing stage.",
+           [](const StageMetrics& s) { return s.calls; });
+    family("radar_stage_allocations_total", "counter", "Heap allocations made by the calling thread inside the stage.",
+           [](const StageMetrics& s) { return s.allocations; });
+    family("radar_stage_allocated_bytes_total", "counter", "Bytes requested by those allocations.",
+           [](const StageMetrics& s) { return s.allocated_bytes; });
+
+    text << "# HELP radar_stage_latency_seconds Wall-clock latency per stage call.\n"
+         << "# TYPE radar_stage_latency_seconds summary\n";
+    for (const auto& s : stages) {
+        const char* name = metricStageName(s.stage);
+        for (double q : {0.5, 0.9, 0.99}) {
+            text << "radar_stage_latency_seconds{stage=\"" << name << "\",quantile=\"" << q << "\"} "
+                 << s.quantile(q) * 1e-9 << "\n";
+        }
+        text << "radar_stage_latency_seconds_sum{stage=\"" << name << "\"} " << s.total_ns * 1e-9 << "\n"
+             << "radar_stage_latency_seconds_count{stage=\"" << name << "\"} " << s.calls << "\n";
+    }
+    return text.str();
+}
+
+bool Metrics::writeFile(const std::string& filename, MetricsFormat format) {
+    auto stages = snapshot();
+    std::string temporary = filename + ".tmp";
+    {
+        std::ofstream file(temporary);
+        if (!file) return false;
+        file << (format == MetricsFormat::Prometheus ? toPrometheus(stages) : toJSON(stages));
+        if (!file) return false;
+    }
+    return std::rename(temporary.c_str(), filename.c_str()) == 0;
+}
+
+ScopedStageTimer::ScopedStageTimer(MetricStage stage) : stage(stage) {
+    uint32_t bit = 1u << static_cast<unsigned>(stage);
+    active = !(active_stages & bit);
+    if (!active) return;
+    active_stages |= bit;
+    threadBlock();
+    start_allocations = Metrics::threadAllocations();
+    start_bytes = threadAllocatedBytes();
+    start = std::chrono::steady_clock::now();
+}
+
+ScopedStageTimer::~ScopedStageTimer() {
+    if (!active) return;
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    active_stages &= ~(1u << static_cast<unsigned>(stage));
+    Metrics::record(stage, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                    Metrics::threadAllocations() - start_allocations, threadAllocatedBytes() - start_bytes);
+}
+
+TaskMetricsScope::TaskMetricsScope() : saved_stages(active_stages) {
+    active_stages = 0;
+}
+
+TaskMetricsScope::~TaskMetricsScope() {
+    active_stages = saved_stages;
+}
+
+MetricsExporter::MetricsExporter(std::string filename, std::chrono::milliseconds interval, MetricsFormat format)
+    : filename(std::move(filename)), interval(interval), format(format) {
+    worker = std::thread([this] {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!cv.wait_for(lock, this->interval, [this] { return stopping; })) {
+            Metrics::writeFile(this->filename, this->format);
+        }
+    });
+}
+
+MetricsExporter::~MetricsExporter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+    worker.join();
+    Metrics::writeFile(filename, format);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Stage instrumentation is compiled in only with -DRADAR_ENABLE_METRICS. Without it RADAR_METRIC_SCOPE
+// expands to nothing, operator new is not replaced, and snapshots are simply empty.
+#ifdef RADAR_ENABLE_METRICS
+#define RADAR_METRIC_CONCAT_(a, b) a##b
+#define RADAR_METRIC_CONCAT(a, b) RADAR_METRIC_CONCAT_(a, b)
+#define RADAR_METRIC_SCOPE(stage) \
+    ::RadarToolkit::ScopedStageTimer RADAR_METRIC_CONCAT(radar_metric_scope_, __LINE__)(stage)
+#define RADAR_METRIC_TASK_SCOPE() \
+    ::RadarToolkit::TaskMetricsScope RADAR_METRIC_CONCAT(radar_metric_task_, __LINE__)
+#else
+#define RADAR_METRIC_SCOPE(stage) ((void)0)
+#define RADAR_METRIC_TASK_SCOPE() ((void)0)
+#endif
+
+namespace RadarToolkit {
+
+enum class MetricStage : uint8_t {
+    GenerateChirp,
+    GenerateBarkerCode,
+    GeneratePulseTrain,
+    AddNoise,
+    AddClutter,
+    PrepareReference,
+    MatchedFilter,
+    PulseCompression,
+    CFAR,
+    CFAR2D,
+    Extraction,
+    Doppler,
+    RangeDopplerMap,
+    FFT,
+    MTI,
+    Integration,
+    BatchScenario,
+    Count
+};
+
+const char* metricStageName(MetricStage stage);
+
+// Log-linear latency buckets in nanoseconds: exact below 16 ns, then 16 sub-buckets per power of two,
+// so any recorded value is within 1/16 of its bucket's lower bound (HdrHistogram with ~1.2 digits).
+struct LatencyBuckets {
+    static constexpr unsigned SUB_BUCKETS = 16;
+    static constexpr unsigned MAX_EXPONENT = 44;
+    static constexpr size_t COUNT = (MAX_EXPONENT - 3) * SUB_BUCKETS;
+
+    static size_t index(uint64_t nanoseconds);
+    static uint64_t lowerBound(size_t index);
+    static uint64_t upperBound(size_t index);
+};
+
+struct StageMetrics {
+    MetricStage stage = MetricStage::Count;
+    uint64_t calls = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t allocations = 0;
+    uint64_t allocated_bytes = 0;
+    std::vector<uint64_t> histogram;
+
+    // Upper edge of the bucket holding the q-quantile call, in nanoseconds.
+    uint64_t quantile(double q) const;
+};
+
+enum class MetricsFormat { JSON, Prometheus };
+
+// Process-wide view over the per-thread counters. Each thread writes only its own block with relaxed
+// atomics, so recording never takes a lock; snapshot() sums every block that has ever been used.
+class Metrics {
+public:
+#ifdef RADAR_ENABLE_METRICS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    // Stages that were called at least once.
+    static std::vector<StageMetrics> snapshot();
+    static void reset();
+
+    static std::string toJSON(const std::vector<StageMetrics>& stages);
+    static std::string toPrometheus(const std::vector<StageMetrics>& stages);
+    // Written to a temporary file and renamed over `filename`, so readers never see a partial dump.
+    static bool writeFile(const std::string& filename, MetricsFormat format);
+
+    // Heap allocations made by the calling thread so far (always 0 when compiled out).
+    static uint64_t threadAllocations();
+    // Heap allocations made by every thread so far.
+    static uint64_t processAllocations();
+
+    static void record(MetricStage stage, uint64_t nanoseconds, uint64_t allocations, uint64_t bytes);
+};
+
+// Times a stage on the calling thread, counting the heap allocations made meanwhile. A scope nested in
+// a scope of the same stage is inert, so overloads that delegate to each other are counted once.
+class ScopedStageTimer {
+public:
+    explicit ScopedStageTimer(MetricStage stage);
+    ~ScopedStageTimer();
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+    MetricStage stage;
+    bool active;
+    uint64_t start_allocations = 0;
+    uint64_t start_bytes = 0;
+    std::chrono::steady_clock::time_point start;
+};
+
+// A thread that helps with pool work may pick up a task while inside its own stage scopes; the task starts
+// a fresh call chain so its scopes are not mistaken for nested ones.
+class TaskMetricsScope {
+public:
+    TaskMetricsScope();
+    ~TaskMetricsScope();
+    TaskMetricsScope(const TaskMetricsScope&) = delete;
+    TaskMetricsScope& operator=(const TaskMetricsScope&) = delete;
+
+private:
+    uint32_t saved_stages;
+};
+
+// Rewrites a metrics file every `interval` from a background thread, and once more on destruction.
+class MetricsExporter {
+public:
+    MetricsExporter(std::string filename, std::chrono::milliseconds interval, MetricsFormat format);
+    ~MetricsExporter();
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+private:
+    std::string filename;
+    std::chrono::milliseconds interval;
+    MetricsFormat format;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::thread worker;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "mti_filter.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+#include "metrics.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+namespace RadarToolkit {
+
+// Range cells per tile: the tile holds every output pulse of the block and stays in cache until written back.
+constexpr size_t RANGE_BLOCK = 256;
+
+template <typename T>
+BasicMTIFilter<T>::BasicMTIFilter(const MTIConfig& config) : config(config) {
+    std::vector<double> taps;
+    switch (config.type) {
+        case MTIType::TwoPulse: taps = {-1.0, 1.0}; break;
+        case MTIType::ThreePulse: taps = {1.0, -2.0, 1.0}; break;
+        case MTIType::FIR: taps = config.coefficients; break;
+    }
+    double energy = 0.0;
+    for (double tap : taps) energy += tap * tap;
+    if (energy == 0.0) return;
+    for (double tap : taps) coefficients.push_back(static_cast<T>(tap / std::sqrt(energy)));
+}
+
+template <typename T>
+void BasicMTIFilter<T>::reset() {
+    std::fill(input_map.begin(), input_map.end(), T(0));
+    std::fill(residual_map.begin(), residual_map.end(), T(0));
+    cpi_count = 0;
+    cancelled = 0;
+}
+
+template <typename T>
+bool BasicMTIFilter<T>::apply(BasicPulseMatrix<T>& cpi) {
+    RADAR_METRIC_SCOPE(MetricStage::MTI);
+    const size_t taps = coefficients.size();
+    const size_t num_pulses = cpi.numPulses();
+    const size_t num_samples = cpi.numSamples();
+    if (taps == 0 || num_pulses < taps) return false;
+    const size_t outputs = num_pulses - taps + 1;
+    const bool mapped = config.clutter_map;
+    if (mapped && input_map.size() != num_samples) {
+        input_map.assign(num_samples, T(0));
+        residual_map.assign(num_samples, T(0));
+        cpi_count = 0;
+    }
+    const bool seeding = cpi_count == 0;
+    const T update = static_cast<T>(config.map_update);
+    const T ratio = static_cast<T>(config.clutter_ratio);
+    std::atomic<size_t> cancelled_cells{0};
+    Workspace::Frame frame(workspace);
+
+    ThreadPool::shared().parallelFor(num_samples, [&](size_t begin, size_t end) {
+        auto tile = workspace.allocate<std::complex<T>>(outputs * RANGE_BLOCK);
+        auto power = workspace.allocate<T>(RANGE_BLOCK);
+        auto input_power = workspace.allocate<T>(RANGE_BLOCK);
+        auto residual_power = workspace.allocate<T>(RANGE_BLOCK);
+        auto cancel = workspace.allocate<uint8_t>(RANGE_BLOCK);
+        size_t block_cancelled = 0;
+        for (size_t r0 = begin; r0 < end; r0 += RANGE_BLOCK) {
+            const size_t width = std::min(end - r0, RANGE_BLOCK);
+            std::fill_n(tile.begin(), outputs * width, std::complex<T>(0));
+            for (size_t p = 0; p < outputs; ++p) {
+                auto out = tile.subspan(p * width, width);
+                for (size_t k = 0; k < taps; ++k) {
+                    BasicSIMDKernels<T>::scaledAdd(std::as_const(cpi).row(p + k).subspan(r0, width), coefficients[k], out);
+                }
+            }
+            if (!mapped) {
+                for (size_t p = 0; p < outputs; ++p) {
+                    std::copy_n(tile.begin() + p * width, width, cpi.row(p).begin() + r0);
+                }
+                block_cancelled += width;
+                continue;
+            }
+
+            std::fill_n(input_power.begin(), width, T(0));
+            std::fill_n(residual_power.begin(), width, T(0));
+            for (size_t p = 0; p < num_pulses; ++p) {
+                BasicSIMDKernels<T>::power(std::as_const(cpi).row(p).subspan(r0, width), power.first(width));
+                for (size_t i = 0; i < width; ++i) input_power[i] += power[i];
+            }
+            for (size_t p = 0; p < outputs; ++p) {
+                BasicSIMDKernels<T>::power(tile.subspan(p * width, width), power.first(width));
+                for (size_t i = 0; i < width; ++i) residual_power[i] += power[i];
+            }
+            // Cells are judged on the map before this CPI's update; the first CPI seeds it.
+            for (size_t i = 0; i < width; ++i) {
+                T& input = input_map[r0 + i];
+                T& residual = residual_map[r0 + i];
+                T fresh_input = input_power[i] / static_cast<T>(num_pulses);
+                T fresh_residual = residual_power[i] / static_cast<T>(outputs);
+                if (seeding) {
+                    input = fresh_input;
+                    residual = fresh_residual;
+                }
+                cancel[i] = input > ratio * residual;
+                block_cancelled += cancel[i];
+                input += update * (fresh_input - input);
+                residual += update * (fresh_residual - residual);
+            }
+            // Row p + taps - 1 is still unwritten when row p takes it.
+            for (size_t p = 0; p < outputs; ++p) {
+                std::complex<T>* row = cpi.row(p).data() + r0;
+                const std::complex<T>* last = cpi.row(p + taps - 1).data() + r0;
+                const std::complex<T>* filtered = tile.data() + p * width;
+                for (size_t i = 0; i < width; ++i) row[i] = cancel[i] ? filtered[i] : last[i];
+            }
+        }
+        cancelled_cells += block_cancelled;
+    }, RANGE_BLOCK);
+
+    if (mapped) ++cpi_count;
+    cancelled = cancelled_cells.load();
+    cpi.resize(outputs, num_samples);
+    return true;
+}
+
+template class BasicMTIFilter<float>;
+template class BasicMTIFilter<double>;
+
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+#include <vector>
+#include <complex>
+#include <span>
+#include "pulse_matrix.h"
+#include "workspace.h"
+
+namespace RadarToolkit {
+
+enum class MTIType {
+    // x[p + 1] - x[p]
+    TwoPulse,
+    // x[p + 2] - 2 x[p + 1] + x[p]
+    ThreePulse,
+    // Real taps across slow time from MTIConfig::coefficients, oldest pulse first.
+    FIR
+};
+
+struct MTIConfig {
+    MTIType type = MTIType::TwoPulse;
+    std::vector<double> coefficients{};
+    // With a clutter map, each range cell keeps recursive averages of its input and cancelled power across CPIs,
+    // weighting the newest CPI by map_update. Only cells whose map shows cancellation removing more than
+    // clutter_ratio of the power are cancelled. The rest pass through unfiltered, so targets in clutter-free
+    // cells escape the canceller's low-Doppler loss. A cell is judged on the map of earlier CPIs, so a target
+    // entering it does not decide its own filtering.
+    bool clutter_map = false;
+    double map_update = 0.125;
+    double clutter_ratio = 2.0;
+};
+
+// Moving-target indication: a pulse canceller run across slow time, ahead of Doppler processing. The taps are
+// scaled to unit white-noise gain, so cancelled and passed-through cells keep the same noise floor.
+template <typename T>
+class BasicMTIFilter {
+public:
+    explicit BasicMTIFilter(const MTIConfig& config);
+
+    // Filters the CPI in place in one pass over range blocks; afterwards it holds numPulses() - taps + 1 pulses,
+    // output pulse p ending at input pulse p + taps - 1. Returns false, leaving the CPI alone, when it has fewer
+    // pulses than taps.
+    bool apply(BasicPulseMatrix<T>& cpi);
+    void reset();
+
+    std::span<const T> taps() const { return coefficients; }
+    // Per range cell: the mean input and cancelled power per pulse, averaged across CPIs.
+    std::span<const T> inputMap() const { return input_map; }
+    std::span<const T> residualMap() const { return residual_map; }
+    // Cells cancelled in the last CPI; every cell without a clutter map.
+    size_t cancelledCells() const { return cancelled; }
+
+private:
+    MTIConfig config;
+    std::vector<T> coefficients;
+    std::vector<T> input_map;
+    std::vector<T> residual_map;
+    size_t cpi_count = 0;
+    size_t cancelled = 0;
+    Workspace workspace;
+};
+
+using MTIFilter = BasicMTIFilter<double>;
+using MTIFilterF = BasicMTIFilter<float>;
+
+}
\ No newline at end of file
@@ -0,0 +1,618 @@
+#include "processing_graph.h"
+#include "signal_generator.h"
+#include "file_io.h"
+#include "random.h"
+#include "thread_pool.h"
+#include "metrics.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <mutex>
+#include <utility>
+
+namespace RadarToolkit {
+
+namespace {
+
+// Both formats are read into named sections of key/value strings; arrays of scalars become comma lists.
+using Section = std::vector<std::pair<std::string, std::string>>;
+using Document = std::vector<std::pair<std::string, Section>>;
+
+std::string trim(std::string_view text) {
+    size_t begin = 0, end = text.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) ++begin;
+    while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) --end;
+    return std::string(text.substr(begin, end - begin));
+}
+
+std::string lower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+bool parseINI(std::string_view text, Document& document, std::string& error) {
+    size_t line_number = 0;
+    while (!text.empty()) {
+        size_t newline = text.find('\n');
+        std::string line = trim(text.substr(0, newline));
+        text = newline == std::string_view::npos ? std::string_view() : text.substr(newline + 1);
+        ++line_number;
+        if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+        if (line.front() == '[') {
+            if (size_t comment = line.find_first_of("#;"); comment != std::string::npos) line = trim(line.substr(0, comment));
+            if (line.back() != ']') {
+                error = "line " + std::to_string(line_number) + ": unterminated section header";
+                return false;
+            }
+            document.emplace_back(lower(trim(std::string_view(line).substr(1, line.size() - 2))), Section{});
+            continue;
+        }
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            error = "line " + std::to_string(line_number) + ": expected key = value";
+            return false;
+        }
+        if (document.empty()) document.emplace_back("pipeline", Section{});
+        std::string value = trim(std::string_view(line).substr(equals + 1));
+        if (size_t comment = value.find_first_of("#;"); comment != std::string::npos) value = trim(value.substr(0, comment));
+        document.back().second.emplace_back(lower(trim(std::string_view(line).substr(0, equals))), value);
+    }
+    return true;
+}
+
+class JSONReader {
+public:
+    explicit JSONReader(std::string_view text) : text(text) {}
+
+    bool document(Document& document) {
+        if (!expect('{')) return false;
+        if (consume('}')) return end();
+        do {
+            std::string key;
+            if (!string(key)) return false;
+            key = lower(key);
+            if (!expect(':')) return false;
+            if (peek() == '{') {
+                document.emplace_back(key, Section{});
+                if (!section(document.back().second)) return false;
+            } else if (peek() == '[' && peekAfterBracket() == '{') {
+                expect('[');
+                if (!consume(']')) {
+                    do {
+                        document.emplace_back(key, Section{});
+                        if (!section(document.back().second)) return false;
+                    } while (consume(','));
+                    if (!expect(']')) return false;
+                }
+            } else {
+                std::string value;
+                if (!scalarOrList(value)) return false;
+                document.emplace_back("pipeline", Section{{key, value}});
+            }
+        } while (consume(','));
+        return expect('}') && end();
+    }
+
+    const std::string& error() const { return message; }
+
+private:
+    std::string_view text;
+    size_t pos = 0;
+    std::string message;
+
+    void skip() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+    }
+    char peek() {
+        skip();
+        return pos < text.size() ? text[pos] : '\0';
+    }
+    char peekAfterBracket() {
+        size_t saved = pos;
+        ++pos;
+        char next = peek();
+        pos = saved;
+        return next;
+    }
+    bool consume(char c) {
+        if (peek() != c) return false;
+        ++pos;
+        return true;
+    }
+    bool fail(const std::string& what) {
+        message = "offset " + std::to_string(pos) + ": " + what;
+        return false;
+    }
+    bool expect(char c) {
+        return consume(c) || fail(std::string("expected '") + c + "'");
+    }
+    bool end() {
+        return peek() == '\0' || fail("unexpected trailing characters");
+    }
+
+    bool string(std::string& out) {
+        if (!expect('"')) return false;
+        for (; pos < text.size() && text[pos] != '"'; ++pos) {
+            if (text[pos] != '\\') {
+                out += text[pos];
+                continue;
+            }
+            if (++pos == text.size()) break;
+            switch (text[pos]) {
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'u': return fail("\\u escapes are not supported");
+                default: out += text[pos];
+            }
+        }
+        if (pos == text.size()) return fail("unterminated string");
+        ++pos;
+        return true;
+    }
+
+    bool scalar(std::string& out) {
+        if (peek() == '"') return string(out);
+        size_t begin = pos;
+        while (pos < text.size() && !std::isspace(static_cast<unsigned char>(text[pos])) &&
+               text[pos] != ',' && text[pos] != ']' && text[pos] != '}') {
+            ++pos;
+        }
+        if (pos == begin) return fail("expected a value");
+        out = std::string(text.substr(begin, pos - begin));
+        return true;
+    }
+
+    bool scalarOrList(std::string& out) {
+        if (!consume('[')) return scalar(out);
+        if (consume(']')) return true;
+        do {
+            std::string item;
+            if (!scalar(item)) return false;
+            out += out.empty() ? item : "," + item;
+        } while (consume(','));
+        return expect(']');
+    }
+
+    bool section(Section& section) {
+        if (!expect('{')) return false;
+        if (consume('}')) return true;
+        do {
+            std::string key, value;
+            if (!string(key) || !expect(':') || !scalarOrList(value)) return false;
+            section.emplace_back(lower(key), value);
+        } while (consume(','));
+        return expect('}');
+    }
+};
+
+bool parseNumber(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0';
+}
+
+template <typename U>
+bool parseCount(const std::string& text, U& value) {
+    if (text.empty() || !std::isdigit(static_cast<unsigned char>(text[0]))) return false;
+    char* end = nullptr;
+    value = static_cast<U>(std::strtoull(text.c_str(), &end, 10));
+    return *end == '\0';
+}
+
+template <typename E, size_t N>
+bool parseName(const std::string& text, const std::pair<const char*, E> (&names)[N], E& value) {
+    std::string word = lower(text);
+    for (const auto& [name, entry] : names) {
+        if (word == name) {
+            value = entry;
+            return true;
+        }
+    }
+    return false;
+}
+
+constexpr std::pair<const char*, GraphStage> STAGE_NAMES[] = {
+    {"scene", GraphStage::Scene}, {"noise", GraphStage::Noise}, {"clutter", GraphStage::Clutter},
+    {"mti", GraphStage::MTI}, {"matched_filter", GraphStage::MatchedFilter}, {"cfar", GraphStage::CFAR},
+    {"rd_map", GraphStage::RangeDopplerMap}, {"cfar2d", GraphStage::CFAR2D}};
+
+constexpr std::pair<const char*, WaveformType> WAVEFORM_NAMES[] = {
+    {"lfm", WaveformType::LFM}, {"nlfm", WaveformType::NLFM}, {"barker", WaveformType::Barker},
+    {"frank", WaveformType::Frank}, {"p1", WaveformType::P1}, {"p2", WaveformType::P2},
+    {"p3", WaveformType::P3}, {"p4", WaveformType::P4}};
+
+constexpr std::pair<const char*, WindowType> WINDOW_NAMES[] = {
+    {"none", WindowType::Rectangular}, {"rectangular", WindowType::Rectangular}, {"hann", WindowType::Hann},
+    {"hamming", WindowType::Hamming}, {"blackman_harris", WindowType::BlackmanHarris},
+    {"taylor", WindowType::Taylor}, {"chebyshev", WindowType::Chebyshev}, {"kaiser", WindowType::Kaiser}};
+
+constexpr std::pair<const char*, CFARType> CFAR_NAMES[] = {
+    {"ca", CFARType::CellAveraging}, {"go", CFARType::GreatestOf}, {"so", CFARType::SmallestOf},
+    {"os", CFARType::OrderStatistic}};
+
+constexpr std::pair<const char*, ClutterAmplitude> CLUTTER_NAMES[] = {
+    {"rayleigh", ClutterAmplitude::Rayleigh}, {"k", ClutterAmplitude::KDistributed},
+    {"weibull", ClutterAmplitude::Weibull}, {"lognormal", ClutterAmplitude::LogNormal}};
+
+constexpr std::pair<const char*, MTIType> MTI_NAMES[] = {
+    {"two_pulse", MTIType::TwoPulse}, {"three_pulse", MTIType::ThreePulse}, {"fir", MTIType::FIR}};
+
+constexpr std::pair<const char*, GraphOutput> OUTPUT_NAMES[] = {
+    {"none", GraphOutput::None}, {"summary", GraphOutput::Summary}, {"csv", GraphOutput::CSV}};
+
+bool parseStages(const std::string& text, std::vector<GraphStage>& stages) {
+    stages.clear();
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        GraphStage stage;
+        if (!parseName(trim(item), STAGE_NAMES, stage)) return false;
+        stages.push_back(stage);
+    }
+    return true;
+}
+
+bool parseNumbers(const std::string& text, std::vector<double>& values) {
+    values.clear();
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        double value;
+        if (!parseNumber(trim(item), value)) return false;
+        values.push_back(value);
+    }
+    return true;
+}
+
+bool parseFlag(const std::string& text, bool& value) {
+    std::string word = lower(text);
+    value = word == "true";
+    return word == "true" || word == "false";
+}
+
+// Applies one key; returns false for an unknown key or a malformed value.
+bool applyKey(const std::string& section, const std::string& key, const std::string& value, GraphConfig& config) {
+    if (section == "radar") {
+        if (key == "waveform") return parseName(value, WAVEFORM_NAMES, config.waveform.type);
+        if (key == "f0") return parseNumber(value, config.waveform.f0);
+        if (key == "bandwidth") return parseNumber(value, config.waveform.bandwidth);
+        if (key == "duration") return parseNumber(value, config.waveform.duration);
+        if (key == "fs") return parseNumber(value, config.waveform.fs);
+        if (key == "code_length") return parseCount(value, config.waveform.code_length);
+        if (key == "chip_rate") return parseNumber(value, config.waveform.chip_rate);
+        if (key == "prf") return parseNumber(value, config.prf);
+        if (key == "pulses") return parseCount(value, config.num_pulses);
+        if (key == "samples_per_pulse") return parseCount(value, config.samples_per_pulse);
+    } else if (section == "pipeline") {
+        if (key == "stages") return parseStages(value, config.stages);
+        if (key == "precision") {
+            std::string word = lower(value);
+            config.single_precision = word == "float";
+            return word == "float" || word == "double";
+        }
+        if (key == "jobs") return parseCount(value, config.jobs);
+        if (key == "seed") return parseCount(value, config.seed);
+        if (key == "output") return parseName(value, OUTPUT_NAMES, config.output);
+        if (key == "output_prefix") {
+            config.output_prefix = value;
+            return true;
+        }
+    } else if (section == "cfar") {
+        if (key == "type") return parseName(value, CFAR_NAMES, config.cfar_type);
+        if (key == "guard") return parseCount(value, config.guard_cells);
+        if (key == "training") return parseCount(value, config.training_cells);
+        if (key == "os_rank") return parseCount(value, config.os_rank);
+        if (key == "guard_doppler") return parseCount(value, config.guard_doppler);
+        if (key == "training_doppler") return parseCount(value, config.training_doppler);
+        if (key == "pfa") return parseNumber(value, config.pfa);
+    } else if (section == "window") {
+        if (key == "range") return parseName(value, WINDOW_NAMES, config.range_window.type);
+        if (key == "doppler") return parseName(value, WINDOW_NAMES, config.doppler_window.type);
+        if (key == "range_parameter") return parseNumber(value, config.range_window.parameter);
+        if (key == "doppler_parameter") return parseNumber(value, config.doppler_window.parameter);
+    } else if (section == "clutter") {
+        if (key == "model") return parseName(value, CLUTTER_NAMES, config.clutter_model.amplitude);
+        if (key == "shape") return parseNumber(value, config.clutter_model.shape);
+        if (key == "doppler_spread") {
+            if (!parseNumber(value, config.clutter_model.doppler_spread)) return false;
+            config.clutter_model.spectrum =
+                config.clutter_model.doppler_spread > 0 ? ClutterSpectrum::Gaussian : ClutterSpectrum::White;
+            return true;
+        }
+    } else if (section == "mti") {
+        if (key == "type") return parseName(value, MTI_NAMES, config.mti.type);
+        if (key == "coefficients") return parseNumbers(value, config.mti.coefficients);
+        if (key == "clutter_map") return parseFlag(value, config.mti.clutter_map);
+        if (key == "map_update") return parseNumber(value, config.mti.map_update);
+        if (key == "clutter_ratio") return parseNumber(value, config.mti.clutter_ratio);
+    } else if (section == "target" || section == "targets") {
+        Target& target = config.targets.back();
+        if (key == "range") return parseNumber(value, target.range);
+        if (key == "velocity") return parseNumber(value, target.velocity);
+        if (key == "rcs") return parseNumber(value, target.rcs);
+    } else if (section == "scenario" || section == "scenarios") {
+        GraphScenario& scenario = config.scenarios.back();
+        if (key == "snr") return parseNumber(value, scenario.snr_db);
+        if (key == "cnr") return parseNumber(value, scenario.cnr_db);
+    }
+    return false;
+}
+
+}
+
+bool ProcessingGraph::load(const std::string& filename, GraphConfig& config, std::string& error) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        error = "cannot open " + filename;
+        return false;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    if (!parse(text.str(), config, error)) {
+        error = filename + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+bool ProcessingGraph::parse(std::string_view text, GraphConfig& config, std::string& error) {
+    Document document;
+    size_t first = text.find_first_not_of(" \t\r\n");
+    if (first != std::string_view::npos && text[first] == '{') {
+        JSONReader reader(text);
+        if (!reader.document(document)) {
+            error = "JSON " + reader.error();
+            return false;
+        }
+    } else if (!parseINI(text, document, error)) {
+        return false;
+    }
+
+    // Listing any target or scenario replaces the defaults rather than appending to them.
+    bool targets_seen = false, scenarios_seen = false;
+    for (const auto& [name, section] : document) {
+        if (name == "target" || name == "targets") {
+            if (!targets_seen) config.targets.clear();
+            targets_seen = true;
+            config.targets.emplace_back();
+        } else if (name == "scenario" || name == "scenarios") {
+            if (!scenarios_seen) config.scenarios.clear();
+            scenarios_seen = true;
+            config.scenarios.emplace_back();
+        }
+        for (const auto& [key, value] : section) {
+            if (!applyKey(name, key, value, config)) {
+                error = "invalid setting " + name + "." + key + " = " + value;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool ProcessingGraph::validate(const GraphConfig& config, std::string& error) {
+    const auto& stages = config.stages;
+    auto position = [&](GraphStage stage) {
+        return static_cast<size_t>(std::find(stages.begin(), stages.end(), stage) - stages.begin());
+    };
+    auto has = [&](GraphStage stage) { return position(stage) < stages.size(); };
+    auto before = [&](GraphStage first, GraphStage second) {
+        return has(first) && has(second) && position(first) < position(second);
+    };
+
+    error.clear();
+    for (GraphStage stage : stages) {
+        if (std::count(stages.begin(), stages.end(), stage) > 1) {
+            error = std::string("stage ") + stageName(stage) + " appears more than once";
+            return false;
+        }
+    }
+    if (stages.empty()) {
+        error = "the pipeline has no stages";
+    } else if (has(GraphStage::Scene) && stages.front() != GraphStage::Scene) {
+        error = "scene must be the first stage";
+    } else if (before(GraphStage::MatchedFilter, GraphStage::Noise) ||
+               before(GraphStage::MatchedFilter, GraphStage::Clutter)) {
+        error = "noise and clutter must come before matched_filter";
+    } else if (before(GraphStage::MTI, GraphStage::Noise) || before(GraphStage::MTI, GraphStage::Clutter)) {
+        error = "noise and clutter must come before mti";
+    } else if (before(GraphStage::RangeDopplerMap, GraphStage::MTI)) {
+        error = "mti must come before rd_map";
+    } else if (before(GraphStage::RangeDopplerMap, GraphStage::Noise) ||
+               before(GraphStage::RangeDopplerMap, GraphStage::Clutter)) {
+        error = "noise and clutter must come before rd_map";
+    } else if (has(GraphStage::CFAR) && !before(GraphStage::MatchedFilter, GraphStage::CFAR)) {
+        error = "cfar needs matched_filter earlier in the pipeline";
+    } else if (has(GraphStage::CFAR2D) && !before(GraphStage::RangeDopplerMap, GraphStage::CFAR2D)) {
+        error = "cfar2d needs rd_map earlier in the pipeline";
+    } else if (config.scenarios.empty()) {
+        error = "no scenarios";
+    } else if (config.num_pulses == 0 || config.waveform.fs <= 0 || config.prf <= 0 || config.waveform.duration <= 0) {
+        error = "pulses, fs, prf and duration must be positive";
+    } else if (config.pfa <= 0 || config.pfa >= 1 || config.training_cells == 0) {
+        error = "pfa must be in (0, 1) and training cells positive";
+    } else if (has(GraphStage::MTI)) {
+        size_t taps = MTIFilter(config.mti).taps().size();
+        if (taps == 0) {
+            error = "mti needs nonzero coefficients";
+        } else if (taps > config.num_pulses) {
+            error = "mti has more taps than the CPI has pulses";
+        } else if (config.mti.map_update <= 0 || config.mti.map_update > 1) {
+            error = "mti map_update must be in (0, 1]";
+        }
+    }
+    return error.empty();
+}
+
+std::vector<GraphStep> ProcessingGraph::plan(const GraphConfig& config) {
+    std::vector<GraphStep> steps;
+    std::vector<char> consumed(config.stages.size(), 0);
+    for (size_t i = 0; i < config.stages.size(); ++i) {
+        if (consumed[i]) continue;
+        steps.push_back({{config.stages[i]}});
+        if (config.stages[i] != GraphStage::MatchedFilter || i + 1 == config.stages.size() ||
+            config.stages[i + 1] != GraphStage::RangeDopplerMap) {
+            continue;
+        }
+        // The fused pass never materialises the compressed pulses, so nothing after it may read them.
+        bool pulses_read = config.output == GraphOutput::CSV ||
+                           std::count(config.stages.begin() + i + 2, config.stages.end(), GraphStage::CFAR) > 0;
+        if (!pulses_read) {
+            steps.back().stages.push_back(GraphStage::RangeDopplerMap);
+            consumed[i + 1] = 1;
+        }
+    }
+    return steps;
+}
+
+std::string ProcessingGraph::describe(const std::vector<GraphStep>& steps) {
+    std::string text;
+    for (const auto& step : steps) {
+        if (!text.empty()) text += " -> ";
+        for (size_t i = 0; i < step.stages.size(); ++i) text += (i ? "+" : "") + std::string(stageName(step.stages[i]));
+    }
+    return text;
+}
+
+const char* ProcessingGraph::stageName(GraphStage stage) {
+    for (const auto& [name, entry] : STAGE_NAMES) {
+        if (entry == stage) return name;
+    }
+    return "unknown";
+}
+
+template <typename T>
+struct BasicGraphRunner<T>::State {
+    BasicPulseMatrix<T> pulses;
+    Workspace workspace;
+    BasicRangeDopplerMap<T> map;
+    std::vector<size_t> range_hits;
+    std::vector<Detection2D> map_hits;
+    BasicMTIFilter<T> mti;
+    BasicTargetExtractor<T> extractor;
+
+    State(size_t workspace_bytes, const MTIConfig& mti_config) : workspace(workspace_bytes), mti(mti_config) {}
+};
+
+template <typename T>
+BasicGraphRunner<T>::BasicGraphRunner(const GraphConfig& config)
+    : config(config), graph_steps(ProcessingGraph::plan(config)),
+      waveform(BasicWaveformLibrary<T>::get(config.waveform, config.range_window)) {
+    SceneConfig scene{config.waveform.f0, config.waveform.fs, config.prf, config.num_pulses, config.samples_per_pulse};
+    samples_per_pulse = config.samples_per_pulse
+        ? config.samples_per_pulse
+        : BasicSceneSimulator<T>::receiveWindow(waveform->samples.size(), config.targets, scene);
+    // The map sees the pulses the MTI canceller leaves.
+    size_t doppler_pulses = config.num_pulses;
+    if (std::count(config.stages.begin(), config.stages.end(), GraphStage::MTI)) {
+        doppler_pulses -= MTIFilter(config.mti).taps().size() - 1;
+    }
+    BasicFFTPlan<T>::get(doppler_pulses);
+    BasicWindowFunction<T>::get(config.doppler_window, doppler_pulses);
+    workspace_bytes = BasicSignalProcessor<T>::workspaceBytes(waveform->spectrum, config.num_pulses, samples_per_pulse);
+}
+
+template <typename T>
+GraphResult BasicGraphRunner<T>::runScenario(size_t index, State& state) const {
+    RADAR_METRIC_SCOPE(MetricStage::BatchScenario);
+    const GraphScenario& scenario = config.scenarios[index];
+    const auto& spectrum = waveform->spectrum;
+    const double f0 = config.waveform.f0, fs = config.waveform.fs;
+    RandomStream rng = RandomStream(config.seed).split(index);
+    GraphResult result;
+    // Scenarios are independent, so none inherits another's clutter map.
+    state.mti.reset();
+
+    if (graph_steps.front().stages.front() != GraphStage::Scene) {
+        state.pulses.resize(config.num_pulses, samples_per_pulse);
+        std::fill(state.pulses.samples().begin(), state.pulses.samples().end(), std::complex<T>(0));
+    }
+    for (const GraphStep& step : graph_steps) {
+        switch (step.stages.front()) {
+            case GraphStage::Scene:
+                BasicSceneSimulator<T>::simulate(waveform->samples, config.targets,
+                                                 {f0, fs, config.prf, config.num_pulses, samples_per_pulse}, state.pulses);
+                break;
+            case GraphStage::Noise:
+                BasicSignalGenerator<T>::addNoise(state.pulses.samples(), scenario.snr_db, rng.split(1));
+                break;
+            case GraphStage::Clutter:
+                BasicClutterGenerator<T>::addClutter(state.pulses, scenario.cnr_db, config.clutter_model, config.prf,
+                                                     rng.split(3));
+                break;
+            case GraphStage::MTI:
+                state.mti.apply(state.pulses);
+                break;
+            case GraphStage::MatchedFilter:
+                if (step.stages.size() > 1) {
+                    BasicSignalProcessor<T>::fusedRangeDopplerMap(state.pulses, spectrum, f0, fs, config.prf,
+                                                                  config.doppler_window, state.map, state.workspace);
+                } else {
+                    BasicSignalProcessor<T>::matchedFilter(state.pulses, spectrum, state.workspace);
+                }
+                break;
+            case GraphStage::CFAR:
+                for (size_t p = 0; p < state.pulses.numPulses(); ++p) {
+                    BasicSignalProcessor<T>::cfarDetection(state.pulses.row(p), config.guard_cells, config.training_cells,
+                                                           config.pfa, config.cfar_type, config.os_rank, state.range_hits,
+                                                           state.workspace);
+                    result.range_detections += state.range_hits.size();
+                }
+                break;
+            case GraphStage::RangeDopplerMap:
+                BasicSignalProcessor<T>::rangeDopplerMap(std::as_const(state.pulses), f0, fs, config.prf,
+                                                         config.doppler_window, state.map, state.workspace);
+                break;
+            case GraphStage::CFAR2D:
+                BasicSignalProcessor<T>::cfarDetection2D(state.map, config.guard_cells, config.guard_doppler,
+                                                         config.training_cells, config.training_doppler, config.pfa,
+                                                         state.map_hits, state.workspace);
+                for (const auto& target : state.extractor.extract(state.map, state.map_hits)) {
+                    result.detections.push_back({target.range, target.velocity, target.snr_db});
+                }
+                break;
+        }
+    }
+
+    if (config.output == GraphOutput::CSV) {
+        result.output_file = config.output_prefix + std::to_string(index) + ".csv";
+        BasicFileIO<T>::saveSignal(state.pulses.row(0), result.output_file);
+    }
+    return result;
+}
+
+template <typename T>
+void BasicGraphRunner<T>::run(const std::function<void(size_t, const GraphResult&)>& report) const {
+    const size_t count = config.scenarios.size();
+    // Scenarios finish out of order; results are released strictly in scenario order.
+    std::vector<GraphResult> results(count);
+    std::vector<char> finished(count, 0);
+    size_t next_report = 0;
+    std::mutex report_mutex;
+
+    ThreadPool pool(config.jobs);
+    ThreadPool::Scope scope(pool);
+    pool.parallelFor(count, [&](size_t begin, size_t end) {
+        State state(workspace_bytes, config.mti);
+        for (size_t index = begin; index < end; ++index) {
+            GraphResult result = runScenario(index, state);
+            std::lock_guard<std::mutex> lock(report_mutex);
+            results[index] = std::move(result);
+            finished[index] = 1;
+            for (; next_report < count && finished[next_report]; ++next_report) {
+                report(next_report, results[next_report]);
+                results[next_report] = {};
+            }
+        }
+    });
+}
+
+template class BasicGraphRunner<float>;
+template class BasicGraphRunner<double>;
+
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#pragma once
+#include <vector>
+#include <complex>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <memory>
+#include <cstdint>
+#include "signal_processor.h"
+#include "waveform_library.h"
+#include "clutter_model.h"
+#include "scene_simulator.h"
+#include "mti_filter.h"
+#include "target_extractor.h"
+
+namespace RadarToolkit {
+
+// Stages of a headless processing run. Every stage works on the scenario's CPI (num_pulses x
+// samples_per_pulse) or on the range-Doppler map made from it.
+enum class GraphStage { Scene, Noise, Clutter, MTI, MatchedFilter, CFAR, RangeDopplerMap, CFAR2D };
+
+enum class GraphOutput { None, Summary, CSV };
+
+struct GraphScenario {
+    double snr_db = 10.0;
+    double cnr_db = 10.0;
+};
+
+struct GraphConfig {
+    WaveformParams waveform{WaveformType::LFM, 1e9, 100e6, 1e-6, 1e9};
+    double prf = 10e3;
+    size_t num_pulses = 10;
+    // 0 sizes the receive window from the targets, as SceneSimulator does.
+    size_t samples_per_pulse = 0;
+    std::vector<Target> targets = {Target{}};
+    ClutterModel clutter_model;
+    MTIConfig mti;
+    WindowSpec range_window;
+    WindowSpec doppler_window{WindowType::Hann};
+    CFARType cfar_type = CFARType::CellAveraging;
+    size_t guard_cells = 5;
+    size_t training_cells = 10;
+    size_t os_rank = 0;
+    size_t guard_doppler = 1;
+    size_t training_doppler = 4;
+    double pfa = 1e-6;
+    std::vector<GraphScenario> scenarios = {GraphScenario{}};
+    std::vector<GraphStage> stages = {GraphStage::Scene, GraphStage::Noise, GraphStage::Clutter,
+                                      GraphStage::MatchedFilter, GraphStage::CFAR, GraphStage::RangeDopplerMap};
+    bool single_precision = false;
+    size_t jobs = 0;
+    uint64_t seed = 1;
+    GraphOutput output = GraphOutput::Summary;
+    // CSV output writes the first compressed pulse of scenario N to <output_prefix>N.csv.
+    std::string output_prefix = "batch_result_";
+};
+
+// One execution step: a stage, or several stages fused into one pass over the CPI.
+struct GraphStep {
+    std::vector<GraphStage> stages;
+};
+
+// One extracted range-Doppler target.
+struct GraphDetection {
+    double range = 0.0;
+    double velocity = 0.0;
+    double snr_db = 0.0;
+};
+
+struct GraphResult {
+    size_t range_detections = 0;
+    std::vector<GraphDetection> detections;
+    std::string output_file;
+};
+
+// Reads pipeline descriptions in INI ([section] / key = value) or JSON. Both map onto the same sections:
+// radar, pipeline, cfar, window, clutter, mti, and repeatable target and scenario sections (JSON arrays of objects
+// under "targets" / "scenarios"). Keys that are not given keep the value already in the config.
+class ProcessingGraph {
+public:
+    static bool load(const std::string& filename, GraphConfig& config, std::string& error);
+    static bool parse(std::string_view text, GraphConfig& config, std::string& error);
+    static bool validate(const GraphConfig& config, std::string& error);
+    // Stage order after fusion: a matched filter joins a range-Doppler map that directly follows it, and the CPI is
+    // compressed a range tile at a time inside the map's corner turn, when no later CFAR stage or CSV output needs
+    // the compressed pulses.
+    static std::vector<GraphStep> plan(const GraphConfig& config);
+    static std::string describe(const std::vector<GraphStep>& steps);
+    static const char* stageName(GraphStage stage);
+};
+
+// Runs a validated config. Construction does all planning: the waveform and its spectrum are fetched from the
+// library, FFT plans for both axes are created, and each worker's workspace is sized for the CPI shape, so
+// scenarios only execute.
+template <typename T>
+class BasicGraphRunner {
+public:
+    explicit BasicGraphRunner(const GraphConfig& config);
+
+    const std::vector<GraphStep>& steps() const { return graph_steps; }
+    size_t samplesPerPulse() const { return samples_per_pulse; }
+
+    // Runs every scenario on a pool of config.jobs threads; report is called once per scenario, in scenario order.
+    void run(const std::function<void(size_t, const GraphResult&)>& report) const;
+
+private:
+    struct State;
+
+    GraphConfig config;
+    std::vector<GraphStep> graph_steps;
+    std::shared_ptr<const typename BasicWaveformLibrary<T>::Waveform> waveform;
+    size_t samples_per_pulse = 0;
+    size_t workspace_bytes = 0;
+
+    GraphResult runScenario(size_t index, State& state) const;
+};
+
+using GraphRunner = BasicGraphRunner<double>;
+using GraphRunnerF = BasicGraphRunner<float>;
+
+}
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "pulse_integrator.h"
+#include "fft_plan.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+#include "metrics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace RadarToolkit {
+
+// Range cells per corner-turn tile in coherent integration, and per power pass in non-coherent integration.
+constexpr size_t RANGE_BLOCK = 32;
+constexpr size_t CELL_BLOCK = 1024;
+
+// CA-CFAR false-alarm probability when the cell under test and each of `cells` training cells hold the sum of
+// `looks` square-law noise samples, for a threshold of alpha times the training mean.
+static double integratedFalseAlarm(double alpha, double looks, double cells) {
+    double x = alpha / cells;
+    double shape = cells * looks;
+    double log_ratio = std::log(x / (1.0 + x));
+    double first = -shape * std::log1p(x);
+    // Terms C(shape + j - 1, j) x^j / (1 + x)^(shape + j) for j < looks, summed in the log domain.
+    double peak = first, log_term = first;
+    for (double j = 1; j < looks; ++j) {
+        log_term += std::log((shape + j - 1.0) / j) + log_ratio;
+        peak = std::max(peak, log_term);
+    }
+    double sum = 0.0;
+    log_term = first;
+    for (double j = 0; j < looks; ++j) {
+        if (j > 0) log_term += std::log((shape + j - 1.0) / j) + log_ratio;
+        sum += std::exp(log_term - peak);
+    }
+    return std::exp(peak) * sum;
+}
+
+// cfarDetection sets its threshold for single-look noise. The single-look pfa whose CA multiplier equals the
+// `looks`-look multiplier for `pfa` makes it exact for CA-CFAR on an integrated score, and a close
+// approximation for the other detectors.
+static double singleLookFalseAlarm(double pfa, double looks, size_t training_cells) {
+    double cells = 2.0 * static_cast<double>(training_cells);
+    double lo = 0.0, hi = 1.0;
+    while (integratedFalseAlarm(hi, looks, cells) > pfa && hi < 1e12) hi *= 2.0;
+    for (int i = 0; i < 100; ++i) {
+        double mid = 0.5 * (lo + hi);
+        (integratedFalseAlarm(mid, looks, cells) > pfa ? lo : hi) = mid;
+    }
+    return std::exp(-cells * std::log1p(hi / cells));
+}
+
+template <typename T>
+BasicPulseIntegrator<T>::BasicPulseIntegrator(const IntegrationConfig& config) : config(config) {}
+
+template <typename T>
+void BasicPulseIntegrator<T>::reset() {
+    std::fill(accumulated.begin(), accumulated.end(), T(0));
+    std::fill(scores.begin(), scores.end(), T(0));
+    integrated_looks = 0.0;
+    cpi_count = 0;
+}
+
+template <typename T>
+void BasicPulseIntegrator<T>::integrate(BasicPulseMatrix<T>& cpi) {
+    RADAR_METRIC_SCOPE(MetricStage::Integration);
+    if (cpi.empty()) return;
+    size_t num_samples = cpi.numSamples();
+    size_t num_rows = config.mode == IntegrationMode::Coherent ? cpi.numPulses() : 1;
+    if (rows != num_rows || scores.size() != num_samples) {
+        rows = num_rows;
+        accumulated.assign(rows * num_samples, T(0));
+        previous.assign(rows * num_samples, T(0));
+        profile.assign(rows * num_samples, T(0));
+        scores.assign(num_samples, T(0));
+        peak_bins.assign(config.mode == IntegrationMode::Coherent ? num_samples : 0, 0);
+        reset();
+    }
+
+    switch (config.mode) {
+        case IntegrationMode::Coherent: coherent(cpi); break;
+        case IntegrationMode::NonCoherent: nonCoherent(cpi); break;
+        case IntegrationMode::Binary: binary(cpi); break;
+    }
+
+    if (cpi_count == 0) {
+        std::copy(profile.begin(), profile.end(), accumulated.begin());
+    } else {
+        std::swap(accumulated, previous);
+        const T forgetting = static_cast<T>(config.forgetting);
+        const size_t walk = config.range_walk;
+        for (size_t row = 0; row < rows; ++row) {
+            const T* last = previous.data() + row * num_samples;
+            const T* fresh = profile.data() + row * num_samples;
+            T* out = accumulated.data() + row * num_samples;
+            for (size_t r = 0; r < num_samples; ++r) {
+                size_t lo = r > walk ? r - walk : 0;
+                size_t hi = std::min(num_samples, r + walk + 1);
+                out[r] = fresh[r] + forgetting * *std::max_element(last + lo, last + hi);
+            }
+        }
+    }
+    if (rows == 1) {
+        std::copy(accumulated.begin(), accumulated.end(), scores.begin());
+    } else {
+        for (size_t r = 0; r < num_samples; ++r) {
+            size_t best = 0;
+            for (size_t row = 1; row < rows; ++row) {
+                if (accumulated[row * num_samples + r] > accumulated[best * num_samples + r]) best = row;
+            }
+            scores[r] = accumulated[best * num_samples + r];
+            peak_bins[r] = static_cast<uint32_t>(best);
+        }
+    }
+    double new_looks = config.mode == IntegrationMode::Coherent ? 1.0 : static_cast<double>(cpi.numPulses());
+    integrated_looks = integrated_looks * config.forgetting + new_looks;
+    ++cpi_count;
+}
+
+template <typename T>
+void BasicPulseIntegrator<T>::coherent(BasicPulseMatrix<T>& cpi) {
+    size_t num_pulses = cpi.numPulses();
+    size_t num_samples = cpi.numSamples();
+    auto taper = BasicWindowFunction<T>::get(config.doppler_window, num_pulses);
+    const std::vector<T>& window = *taper;
+    auto plan = BasicFFTPlan<T>::get(num_pulses);
+    Workspace::Frame frame(workspace);
+
+    // Same tiled corner turn as the range-Doppler map, but the spectra are written back over the CPI.
+    ThreadPool::shared().parallelFor(num_samples, [&](size_t begin, size_t end) {
+        auto turned = workspace.allocate<std::complex<T>>(RANGE_BLOCK * num_pulses);
+        auto power = workspace.allocate<T>(num_pulses);
+        for (size_t r0 = begin; r0 < end; r0 += RANGE_BLOCK) {
+            size_t r1 = std::min(end, r0 + RANGE_BLOCK);
+            for (size_t p = 0; p < num_pulses; ++p) {
+                const std::complex<T>* row = cpi.row(p).data();
+                for (size_t r = r0; r < r1; ++r) turned[(r - r0) * num_pulses + p] = row[r] * window[p];
+            }
+            for (size_t r = r0; r < r1; ++r) {
+                auto slow_time = turned.subspan((r - r0) * num_pulses, num_pulses);
+                plan->forward(slow_time);
+                BasicSIMDKernels<T>::power(slow_time, power);
+                for (size_t k = 0; k < num_pulses; ++k) profile[k * num_samples + r] = power[k];
+            }
+            for (size_t p = 0; p < num_pulses; ++p) {
+                std::complex<T>* row = cpi.row(p).data();
+                for (size_t r = r0; r < r1; ++r) row[r] = turned[(r - r0) * num_pulses + p];
+            }
+        }
+    }, RANGE_BLOCK);
+}
+
+template <typename T>
+void BasicPulseIntegrator<T>::nonCoherent(const BasicPulseMatrix<T>& cpi) {
+    size_t num_samples = cpi.numSamples();
+    Workspace::Frame frame(workspace);
+
+    ThreadPool::shared().parallelFor(num_samples, [&](size_t begin, size_t end) {
+        auto power = workspace.allocate<T>(CELL_BLOCK);
+        for (size_t c0 = begin; c0 < end; c0 += CELL_BLOCK) {
+            size_t cells = std::min(end - c0, CELL_BLOCK);
+            std::fill_n(profile.begin() + c0, cells, T(0));
+            for (size_t p = 0; p < cpi.numPulses(); ++p) {
+                BasicSIMDKernels<T>::power(cpi.row(p).subspan(c0, cells), power.first(cells));
+                for (size_t i = 0; i < cells; ++i) profile[c0 + i] += power[i];
+            }
+        }
+    }, CELL_BLOCK);
+}
+
+template <typename T>
+void BasicPulseIntegrator<T>::binary(const BasicPulseMatrix<T>& cpi) {
+    std::fill(profile.begin(), profile.end(), T(0));
+    for (size_t p = 0; p < cpi.numPulses(); ++p) {
+        BasicSignalProcessor<T>::cfarDetection(cpi.row(p), config.guard_cells, config.training_cells, config.pfa,
+                                               config.cfar_type, 0, hits, workspace);
+        for (size_t index : hits) profile[index] += T(1);
+    }
+}
+
+template <typename T>
+void BasicPulseIntegrator<T>::detect(size_t guard_cells, size_t training_cells, double pfa, CFARType type,
+                                     std::vector<size_t>& detections) {
+    detections.clear();
+    if (scores.empty()) return;
+    if (config.mode == IntegrationMode::Binary) {
+        double m = config.m ? static_cast<double>(config.m) : std::max(1.0, std::round(1.5 * std::sqrt(integrated_looks)));
+        for (size_t r = 0; r < scores.size(); ++r) {
+            if (scores[r] >= m) detections.push_back(r);
+        }
+        return;
+    }
+
+    // Every Doppler bin is a separate test of the range cell, so each gets pfa / rows.
+    double looks = std::max(1.0, std::round(integrated_looks));
+    if (looks != cached_looks || pfa != cached_pfa || training_cells != cached_training || rows != cached_rows) {
+        double bin_pfa = pfa / static_cast<double>(rows);
+        cached_single_look_pfa = looks > 1.0 ? singleLookFalseAlarm(bin_pfa, looks, training_cells) : bin_pfa;
+        cached_looks = looks;
+        cached_pfa = pfa;
+        cached_training = training_cells;
+        cached_rows = rows;
+    }
+    size_t num_samples = scores.size();
+    for (size_t row = 0; row < rows; ++row) {
+        BasicSignalProcessor<T>::cfarDetection(std::span<const T>(accumulated).subspan(row * num_samples, num_samples),
+                                               guard_cells, training_cells, cached_single_look_pfa, type, 0, hits,
+                                               workspace);
+        detections.insert(detections.end(), hits.begin(), hits.end());
+    }
+    if (rows > 1) {
+        std::sort(detections.begin(), detections.end());
+        detections.erase(std::unique(detections.begin(), detections.end()), detections.end());
+    }
+}
+
+template class BasicPulseIntegrator<float>;
+template class BasicPulseIntegrator<double>;
+
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+#include <vector>
+#include <complex>
+#include <span>
+#include <cstdint>
+#include "signal_processor.h"
+#include "pulse_matrix.h"
+#include "window.h"
+#include "workspace.h"
+
+namespace RadarToolkit {
+
+enum class IntegrationMode {
+    // Doppler-bank FFT across the pulses of each range cell. Bin powers are accumulated per Doppler bin, and a cell
+    // is detected when any bin passes CFAR along range.
+    Coherent,
+    // Square-law sum of the pulse powers.
+    NonCoherent,
+    // Single-pulse CFAR on every pulse; the cell scores its number of hits and is declared at M of N.
+    Binary
+};
+
+struct IntegrationConfig {
+    IntegrationMode mode = IntegrationMode::NonCoherent;
+    WindowSpec doppler_window{};
+    // Single-pulse detector for binary integration.
+    size_t guard_cells = 5;
+    size_t training_cells = 10;
+    double pfa = 1e-3;
+    CFARType cfar_type = CFARType::CellAveraging;
+    // Hits needed for a binary detection; 0 picks round(1.5 sqrt(N)) for the N looks integrated so far.
+    size_t m = 0;
+    // Across CPIs the score follows score[r] = cpi[r] + forgetting * max(previous score within +/- range_walk),
+    // a dynamic-programming track-before-detect that lets a target move range_walk cells per CPI.
+    // forgetting 1 with range_walk 0 is a plain running sum.
+    double forgetting = 1.0;
+    size_t range_walk = 0;
+};
+
+// Streaming pulse integration: each CPI is folded into one score per range cell that is carried across CPIs,
+// so weak targets build up without keeping past CPIs. The score feeds cfarDetection directly through detect().
+template <typename T>
+class BasicPulseIntegrator {
+public:
+    explicit BasicPulseIntegrator(const IntegrationConfig& config);
+
+    // Coherent mode transforms the CPI in place: afterwards row k holds Doppler bin k (unshifted).
+    void integrate(BasicPulseMatrix<T>& cpi);
+    void reset();
+
+    // Per range cell; in coherent mode the strongest accumulated Doppler bin.
+    std::span<const T> score() const { return scores; }
+    // Coherent mode: that bin's index, unshifted.
+    std::span<const uint32_t> dopplerBins() const { return peak_bins; }
+    // Independent looks in the score, discounted by the forgetting factor: pulses for non-coherent and binary
+    // integration, CPIs for coherent integration.
+    double looks() const { return integrated_looks; }
+    size_t cpis() const { return cpi_count; }
+
+    // Binary mode applies the M-of-N rule. The other modes run CFAR over the score, with the threshold set for
+    // the number of looks integrated so pfa holds per range cell.
+    void detect(size_t guard_cells, size_t training_cells, double pfa, CFARType type, std::vector<size_t>& detections);
+
+private:
+    IntegrationConfig config;
+    // One row per Doppler bin in coherent mode, otherwise a single row.
+    std::vector<T> accumulated;
+    std::vector<T> previous;
+    std::vector<T> profile;
+    std::vector<T> scores;
+    std::vector<uint32_t> peak_bins;
+    std::vector<size_t> hits;
+    double integrated_looks = 0.0;
+    size_t cpi_count = 0;
+    size_t rows = 1;
+    double cached_looks = 0.0;
+    double cached_pfa = 0.0;
+    size_t cached_training = 0;
+    size_t cached_rows = 0;
+    double cached_single_look_pfa = 0.0;
+    Workspace workspace;
+
+    void coherent(BasicPulseMatrix<T>& cpi);
+    void nonCoherent(const BasicPulseMatrix<T>& cpi);
+    void binary(const BasicPulseMatrix<T>& cpi);
+};
+
+using PulseIntegrator = BasicPulseIntegrator<double>;
+using PulseIntegratorF = BasicPulseIntegrator<float>;
+
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#pragma once
+#include <vector>
+#include <complex>
+#include <span>
+#include <algorithm>
+#include <cstddef>
+#include "aligned_allocator.h"
+
+namespace RadarToolkit {
+
+template <typename V>
+class StridedView {
+public:
+    StridedView(V* data, size_t count, size_t stride) : ptr(data), count(count), stride(stride) {}
+    V& operator[](size_t i) const { return ptr[i * stride]; }
+    size_t size() const { return count; }
+
+private:
+    V* ptr;
+    size_t count;
+    size_t stride;
+};
+
+// A CPI in memory the toolkit does not own: num_pulses rows of num_samples contiguous samples, row_stride
+// samples apart (negative for a reversed slow-time axis).
+template <typename V>
+class PulseView {
+public:
+    PulseView(V* data, size_t num_pulses, size_t num_samples, ptrdiff_t row_stride)
+        : ptr(data), pulses(num_pulses), samples_per_pulse(num_samples), stride(row_stride) {}
+
+    size_t numPulses() const { return pulses; }
+    size_t numSamples() const { return samples_per_pulse; }
+    bool empty() const { return pulses == 0 || samples_per_pulse == 0; }
+    std::span<V> row(size_t pulse) const { return {ptr + static_cast<ptrdiff_t>(pulse) * stride, samples_per_pulse}; }
+
+private:
+    V* ptr;
+    size_t pulses;
+    size_t samples_per_pulse;
+    ptrdiff_t stride;
+};
+
+// One coherent processing interval: num_pulses rows of num_samples fast-time samples in a
+// single 64-byte-aligned, row-major allocation. Rows are contiguous spans; columns (one range
+// bin across slow time) are strided views.
+template <typename T>
+class BasicPulseMatrix {
+public:
+    using value_type = std::complex<T>;
+
+    BasicPulseMatrix() = default;
+    BasicPulseMatrix(size_t num_pulses, size_t num_samples) { resize(num_pulses, num_samples); }
+
+    void resize(size_t num_pulses, size_t num_samples) {
+        pulses = num_pulses;
+        samples_per_pulse = num_samples;
+        storage.resize(num_pulses * num_samples);
+    }
+    void fill(value_type value) { std::fill(storage.begin(), storage.end(), value); }
+
+    size_t numPulses() const { return pulses; }
+    size_t numSamples() const { return samples_per_pulse; }
+    size_t size() const { return storage.size(); }
+    bool empty() const { return storage.empty(); }
+
+    value_type* data() { return storage.data(); }
+    const value_type* data() const { return storage.data(); }
+    std::span<value_type> samples() { return storage; }
+    std::span<const value_type> samples() const { return storage; }
+
+    PulseView<value_type> view() { return {data(), pulses, samples_per_pulse, static_cast<ptrdiff_t>(samples_per_pulse)}; }
+    PulseView<const value_type> view() const {
+        return {data(), pulses, samples_per_pulse, static_cast<ptrdiff_t>(samples_per_pulse)};
+    }
+    std::span<value_type> row(size_t pulse) { return {data() + pulse * samples_per_pulse, samples_per_pulse}; }
+    std::span<const value_type> row(size_t pulse) const { return {data() + pulse * samples_per_pulse, samples_per_pulse}; }
+    StridedView<value_type> column(size_t sample) { return {data() + sample, pulses, samples_per_pulse}; }
+    StridedView<const value_type> column(size_t sample) const { return {data() + sample, pulses, samples_per_pulse}; }
+
+    value_type& operator()(size_t pulse, size_t sample) { return storage[pulse * samples_per_pulse + sample]; }
+    const value_type& operator()(size_t pulse, size_t sample) const { return storage[pulse * samples_per_pulse + sample]; }
+
+private:
+    size_t pulses = 0;
+    size_t samples_per_pulse = 0;
+    std::vector<value_type, AlignedAllocator<value_type>> storage;
+};
+
+// Split real/imaginary (structure-of-arrays) layout of the same CPI, for kernels that want
+// unit-stride real and imaginary lanes.
+template <typename T>
+class BasicSplitPulseMatrix {
+public:
+    BasicSplitPulseMatrix() = default;
+    explicit BasicSplitPulseMatrix(const BasicPulseMatrix<T>& interleaved) { assign(interleaved); }
+
+    void assign(const BasicPulseMatrix<T>& interleaved) {
+        pulses = interleaved.numPulses();
+        samples_per_pulse = interleaved.numSamples();
+        real_part.resize(interleaved.size());
+        imag_part.resize(interleaved.size());
+        const auto* src = interleaved.data();
+        for (size_t i = 0; i < interleaved.size(); ++i) {
+            real_part[i] = src[i].real();
+            imag_part[i] = src[i].imag();
+        }
+    }
+    void toInterleaved(BasicPulseMatrix<T>& out) const {
+        out.resize(pulses, samples_per_pulse);
+        auto* dst = out.data();
+        for (size_t i = 0; i < real_part.size(); ++i) dst[i] = {real_part[i], imag_part[i]};
+    }
+
+    size_t numPulses() const { return pulses; }
+    size_t numSamples() const { return samples_per_pulse; }
+    std::span<T> real(size_t pulse) { return {real_part.data() + pulse * samples_per_pulse, samples_per_pulse}; }
+    std::span<T> imag(size_t pulse) { return {imag_part.data() + pulse * samples_per_pulse, samples_per_pulse}; }
+    std::span<const T> real(size_t pulse) const { return {real_part.data() + pulse * samples_per_pulse, samples_per_pulse}; }
+    std::span<const T> imag(size_t pulse) const { return {imag_part.data() + pulse * samples_per_pulse, samples_per_pulse}; }
+
+private:
+    size_t pulses = 0;
+    size_t samples_per_pulse = 0;
+    std::vector<T, AlignedAllocator<T>> real_part;
+    std::vector<T, AlignedAllocator<T>> imag_part;
+};
+
+using PulseMatrix = BasicPulseMatrix<double>;
+using PulseMatrixF = BasicPulseMatrix<float>;
+using SplitPulseMatrix = BasicSplitPulseMatrix<double>;
+using SplitPulseMatrixF = BasicSplitPulseMatrix<float>;
+
+}
\ No newline at end of file
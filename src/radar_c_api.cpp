@@ -0,0 +1,319 @@
+#include "radar_c_api.h"
+#include "signal_processor.h"
+#include "waveform_library.h"
+#include "thread_pool.h"
+#include "workspace.h"
+#include <algorithm>
+#include <complex>
+#include <memory>
+#include <new>
+#include <span>
+#include <vector>
+
+using namespace RadarToolkit;
+
+struct radar_context {
+    std::unique_ptr<ThreadPool> pool;
+    Workspace workspace;
+    std::vector<size_t> detections;
+    std::vector<Detection2D> detections_2d;
+};
+
+struct radar_reference {
+    ReferenceSpectrum spectrum;
+};
+
+struct radar_reference_f {
+    ReferenceSpectrumF spectrum;
+};
+
+namespace {
+
+// Exceptions must not cross the C boundary; the body runs on the context's pool when it has one.
+template <typename F>
+ptrdiff_t guarded(radar_context* context, F&& body) {
+    if (!context) return RADAR_ERROR_ARGUMENT;
+    try {
+        if (!context->pool) return body();
+        ThreadPool::Scope scope(*context->pool);
+        return body();
+    } catch (const std::bad_alloc&) {
+        return RADAR_ERROR_MEMORY;
+    } catch (...) {
+        return RADAR_ERROR_INTERNAL;
+    }
+}
+
+bool windowSpec(int window, double parameter, WindowSpec& spec) {
+    if (window < RADAR_WINDOW_RECTANGULAR || window > RADAR_WINDOW_KAISER) return false;
+    spec.type = static_cast<WindowType>(window);
+    spec.parameter = parameter;
+    return true;
+}
+
+// The caller's samples in place when they are contiguous, else a copy in the workspace's open frame.
+template <typename T>
+std::span<const std::complex<T>> gather(Workspace& workspace, const T* data, size_t length, ptrdiff_t stride) {
+    const auto* samples = reinterpret_cast<const std::complex<T>*>(data);
+    if (stride == 1) return {samples, length};
+    auto copy = workspace.allocate<std::complex<T>>(length);
+    for (size_t i = 0; i < length; ++i) copy[i] = samples[static_cast<ptrdiff_t>(i) * stride];
+    return copy;
+}
+
+template <typename T>
+std::span<std::complex<T>> scratch(Workspace& workspace, T* data, size_t length, ptrdiff_t stride) {
+    if (stride == 1) return {reinterpret_cast<std::complex<T>*>(data), length};
+    return workspace.allocate<std::complex<T>>(length);
+}
+
+template <typename T>
+void scatter(std::span<const std::complex<T>> values, T* data, ptrdiff_t stride) {
+    if (stride == 1) return;
+    auto* samples = reinterpret_cast<std::complex<T>*>(data);
+    for (size_t i = 0; i < values.size(); ++i) samples[static_cast<ptrdiff_t>(i) * stride] = values[i];
+}
+
+template <typename T>
+int generateChirp(radar_context* context, double f0, double bandwidth, double duration, double fs, T* out,
+                  size_t length, ptrdiff_t stride) {
+    return static_cast<int>(guarded(context, [&]() -> ptrdiff_t {
+        WaveformParams params{WaveformType::LFM, f0, bandwidth, duration, fs};
+        if (!out || length == 0 || stride == 0 || length != BasicWaveformLibrary<T>::length(params)) {
+            return RADAR_ERROR_ARGUMENT;
+        }
+        Workspace::Frame frame(context->workspace);
+        auto chirp = scratch(context->workspace, out, length, stride);
+        BasicWaveformLibrary<T>::generate(params, chirp);
+        scatter<T>(chirp, out, stride);
+        return RADAR_OK;
+    }));
+}
+
+template <typename Reference, typename T>
+Reference* createReference(const T* samples, size_t length, ptrdiff_t stride, size_t fft_size, int window,
+                           double window_parameter) {
+    WindowSpec spec;
+    if (!samples || length == 0 || stride == 0 || !windowSpec(window, window_parameter, spec)) return nullptr;
+    try {
+        Workspace workspace;
+        Workspace::Frame frame(workspace);
+        auto reference = std::make_unique<Reference>();
+        reference->spectrum = BasicSignalProcessor<T>::prepareReference(gather(workspace, samples, length, stride),
+                                                                        fft_size, spec);
+        return reference.release();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+template <typename T, typename Reference>
+int matchedFilter(radar_context* context, const Reference* reference, const T* signal, ptrdiff_t signal_stride,
+                  T* out, ptrdiff_t out_stride, size_t length) {
+    return static_cast<int>(guarded(context, [&]() -> ptrdiff_t {
+        if (!reference || !signal || !out || length == 0 || signal_stride == 0 || out_stride == 0) {
+            return RADAR_ERROR_ARGUMENT;
+        }
+        Workspace::Frame frame(context->workspace);
+        auto input = gather(context->workspace, signal, length, signal_stride);
+        auto output = scratch(context->workspace, out, length, out_stride);
+        BasicSignalProcessor<T>::matchedFilter(input, reference->spectrum, output, context->workspace);
+        scatter<T>(output, out, out_stride);
+        return RADAR_OK;
+    }));
+}
+
+template <typename T, typename Reference>
+int matchedFilterCPI(radar_context* context, const Reference* reference, T* pulses, size_t num_pulses,
+                     size_t num_samples, ptrdiff_t pulse_stride) {
+    return static_cast<int>(guarded(context, [&]() -> ptrdiff_t {
+        // Rows compressed in place must not overlap.
+        size_t row_distance = static_cast<size_t>(pulse_stride < 0 ? -pulse_stride : pulse_stride);
+        if (!reference || !pulses || num_pulses == 0 || num_samples == 0 ||
+            (num_pulses > 1 && row_distance < num_samples)) {
+            return RADAR_ERROR_ARGUMENT;
+        }
+        PulseView<std::complex<T>> view(reinterpret_cast<std::complex<T>*>(pulses), num_pulses, num_samples,
+                                        pulse_stride);
+        BasicSignalProcessor<T>::matchedFilter(view, reference->spectrum, context->workspace);
+        return RADAR_OK;
+    }));
+}
+
+template <typename T>
+int rangeDoppler(radar_context* context, const T* pulses, size_t num_pulses, size_t num_samples,
+                 ptrdiff_t pulse_stride, int window, double window_parameter, T* magnitudes) {
+    return static_cast<int>(guarded(context, [&]() -> ptrdiff_t {
+        WindowSpec spec;
+        if (!pulses || !magnitudes || num_pulses == 0 || num_samples == 0 ||
+            !windowSpec(window, window_parameter, spec)) {
+            return RADAR_ERROR_ARGUMENT;
+        }
+        PulseView<const std::complex<T>> view(reinterpret_cast<const std::complex<T>*>(pulses), num_pulses,
+                                              num_samples, pulse_stride);
+        BasicSignalProcessor<T>::rangeDopplerMagnitudes(view, spec, {magnitudes, num_pulses * num_samples},
+                                                        context->workspace);
+        return RADAR_OK;
+    }));
+}
+
+template <typename T>
+ptrdiff_t cfar(radar_context* context, const T* signal, size_t length, ptrdiff_t stride, size_t guard_cells,
+               size_t training_cells, double pfa, int type, size_t os_rank, size_t* detections, size_t capacity) {
+    return guarded(context, [&]() -> ptrdiff_t {
+        if (!signal || length == 0 || stride == 0 || training_cells == 0 || !(pfa > 0.0 && pfa < 1.0) ||
+            type < RADAR_CFAR_CELL_AVERAGING || type > RADAR_CFAR_ORDER_STATISTIC || (capacity && !detections)) {
+            return RADAR_ERROR_ARGUMENT;
+        }
+        Workspace::Frame frame(context->workspace);
+        BasicSignalProcessor<T>::cfarDetection(gather(context->workspace, signal, length, stride), guard_cells,
+                                               training_cells, pfa, static_cast<CFARType>(type), os_rank,
+                                               context->detections, context->workspace);
+        size_t found = context->detections.size();
+        std::copy_n(context->detections.begin(), std::min(found, capacity), detections);
+        return static_cast<ptrdiff_t>(found);
+    });
+}
+
+template <typename T>
+ptrdiff_t cfar2D(radar_context* context, const T* magnitudes, size_t num_range_bins, size_t num_doppler_bins,
+                 size_t guard_range, size_t guard_doppler, size_t training_range, size_t training_doppler, double pfa,
+                 size_t* range_bins, size_t* doppler_bins, size_t capacity) {
+    return guarded(context, [&]() -> ptrdiff_t {
+        if (!magnitudes || num_range_bins == 0 || num_doppler_bins == 0 || !(pfa > 0.0 && pfa < 1.0) ||
+            (capacity && (!range_bins || !doppler_bins))) {
+            return RADAR_ERROR_ARGUMENT;
+        }
+        BasicSignalProcessor<T>::cfarDetection2D({magnitudes, num_range_bins * num_doppler_bins}, num_range_bins,
+                                                 num_doppler_bins, guard_range, guard_doppler, training_range,
+                                                 training_doppler, pfa, context->detections_2d, context->workspace);
+        size_t found = context->detections_2d.size();
+        for (size_t i = 0; i < std::min(found, capacity); ++i) {
+            range_bins[i] = context->detections_2d[i].range_bin;
+            doppler_bins[i] = context->detections_2d[i].doppler_bin;
+        }
+        return static_cast<ptrdiff_t>(found);
+    });
+}
+
+}
+
+extern "C" {
+
+int radar_api_version(void) {
+    return RADAR_API_VERSION;
+}
+
+const char* radar_status_message(int status) {
+    switch (status) {
+        case RADAR_OK: return "ok";
+        case RADAR_ERROR_ARGUMENT: return "invalid argument";
+        case RADAR_ERROR_MEMORY: return "out of memory";
+        case RADAR_ERROR_INTERNAL: return "internal error";
+        default: return status > 0 ? "ok" : "unknown status";
+    }
+}
+
+radar_context* radar_context_create(size_t threads) {
+    try {
+        auto context = std::make_unique<radar_context>();
+        if (threads > 0) context->pool = std::make_unique<ThreadPool>(threads);
+        return context.release();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void radar_context_destroy(radar_context* context) {
+    delete context;
+}
+
+size_t radar_chirp_length(double duration, double fs) {
+    return WaveformLibrary::length({WaveformType::LFM, 0.0, 0.0, duration, fs});
+}
+
+int radar_generate_chirp(radar_context* context, double f0, double bandwidth, double duration, double fs, double* out,
+                         size_t length, ptrdiff_t stride) {
+    return generateChirp(context, f0, bandwidth, duration, fs, out, length, stride);
+}
+
+int radar_generate_chirp_f(radar_context* context, double f0, double bandwidth, double duration, double fs, float* out,
+                           size_t length, ptrdiff_t stride) {
+    return generateChirp(context, f0, bandwidth, duration, fs, out, length, stride);
+}
+
+radar_reference* radar_reference_create(const double* samples, size_t length, ptrdiff_t stride, size_t fft_size,
+                                        int window, double window_parameter) {
+    return createReference<radar_reference>(samples, length, stride, fft_size, window, window_parameter);
+}
+
+radar_reference_f* radar_reference_create_f(const float* samples, size_t length, ptrdiff_t stride, size_t fft_size,
+                                            int window, double window_parameter) {
+    return createReference<radar_reference_f>(samples, length, stride, fft_size, window, window_parameter);
+}
+
+void radar_reference_destroy(radar_reference* reference) {
+    delete reference;
+}
+
+void radar_reference_destroy_f(radar_reference_f* reference) {
+    delete reference;
+}
+
+int radar_matched_filter(radar_context* context, const radar_reference* reference, const double* signal,
+                         ptrdiff_t signal_stride, double* out, ptrdiff_t out_stride, size_t length) {
+    return matchedFilter(context, reference, signal, signal_stride, out, out_stride, length);
+}
+
+int radar_matched_filter_f(radar_context* context, const radar_reference_f* reference, const float* signal,
+                           ptrdiff_t signal_stride, float* out, ptrdiff_t out_stride, size_t length) {
+    return matchedFilter(context, reference, signal, signal_stride, out, out_stride, length);
+}
+
+int radar_matched_filter_cpi(radar_context* context, const radar_reference* reference, double* pulses,
+                             size_t num_pulses, size_t num_samples, ptrdiff_t pulse_stride) {
+    return matchedFilterCPI(context, reference, pulses, num_pulses, num_samples, pulse_stride);
+}
+
+int radar_matched_filter_cpi_f(radar_context* context, const radar_reference_f* reference, float* pulses,
+                               size_t num_pulses, size_t num_samples, ptrdiff_t pulse_stride) {
+    return matchedFilterCPI(context, reference, pulses, num_pulses, num_samples, pulse_stride);
+}
+
+int radar_range_doppler(radar_context* context, const double* pulses, size_t num_pulses, size_t num_samples,
+                        ptrdiff_t pulse_stride, int window, double window_parameter, double* magnitudes) {
+    return rangeDoppler(context, pulses, num_pulses, num_samples, pulse_stride, window, window_parameter, magnitudes);
+}
+
+int radar_range_doppler_f(radar_context* context, const float* pulses, size_t num_pulses, size_t num_samples,
+                          ptrdiff_t pulse_stride, int window, double window_parameter, float* magnitudes) {
+    return rangeDoppler(context, pulses, num_pulses, num_samples, pulse_stride, window, window_parameter, magnitudes);
+}
+
+ptrdiff_t radar_cfar(radar_context* context, const double* signal, size_t length, ptrdiff_t stride, size_t guard_cells,
+                     size_t training_cells, double pfa, int type, size_t os_rank, size_t* detections, size_t capacity) {
+    return cfar(context, signal, length, stride, guard_cells, training_cells, pfa, type, os_rank, detections, capacity);
+}
+
+ptrdiff_t radar_cfar_f(radar_context* context, const float* signal, size_t length, ptrdiff_t stride, size_t guard_cells,
+                       size_t training_cells, double pfa, int type, size_t os_rank, size_t* detections, size_t capacity) {
+    return cfar(context, signal, length, stride, guard_cells, training_cells, pfa, type, os_rank, detections, capacity);
+}
+
+ptrdiff_t radar_cfar_2d(radar_context* context, const double* magnitudes, size_t num_range_bins,
+                        size_t num_doppler_bins, size_t guard_range, size_t guard_doppler, size_t training_range,
+                        size_t training_doppler, double pfa, size_t* range_bins, size_t* doppler_bins,
+                        size_t capacity) {
+    return cfar2D(context, magnitudes, num_range_bins, num_doppler_bins, guard_range, guard_doppler, training_range,
+                  training_doppler, pfa, range_bins, doppler_bins, capacity);
+}
+
+ptrdiff_t radar_cfar_2d_f(radar_context* context, const float* magnitudes, size_t num_range_bins,
+                          size_t num_doppler_bins, size_t guard_range, size_t guard_doppler, size_t training_range,
+                          size_t training_doppler, double pfa, size_t* range_bins, size_t* doppler_bins,
+                          size_t capacity) {
+    return cfar2D(context, magnitudes, num_range_bins, num_doppler_bins, guard_range, guard_doppler, training_range,
+                  training_doppler, pfa, range_bins, doppler_bins, capacity);
+}
+
+}
\ No newline at end of file
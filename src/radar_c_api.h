@@ -0,0 +1,115 @@
+#pragma once
+#include <stddef.h>
+
+// C interface to the processing chain for other languages; main.py loads it through ctypes. Complex buffers
+// are interleaved (re, im) pairs of double, or of float for the functions ending in _f: the layout of NumPy's
+// complex128 and complex64. Lengths count complex samples and strides count samples, not bytes. Buffers with
+// stride 1 are processed where they lie; other strides are gathered through the context's workspace. No call
+// keeps a pointer after it returns or calls back into the caller, so bindings can release their interpreter
+// lock around every call.
+
+#if defined(_WIN32)
+#define RADAR_API __declspec(dllexport)
+#else
+#define RADAR_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RADAR_API_VERSION 1
+
+enum {
+    RADAR_OK = 0,
+    // A null pointer, an empty buffer, or a parameter out of range.
+    RADAR_ERROR_ARGUMENT = -1,
+    RADAR_ERROR_MEMORY = -2,
+    RADAR_ERROR_INTERNAL = -3
+};
+
+// Same order as RadarToolkit::WindowType.
+enum {
+    RADAR_WINDOW_RECTANGULAR,
+    RADAR_WINDOW_HANN,
+    RADAR_WINDOW_HAMMING,
+    RADAR_WINDOW_BLACKMAN_HARRIS,
+    RADAR_WINDOW_TAYLOR,
+    RADAR_WINDOW_CHEBYSHEV,
+    RADAR_WINDOW_KAISER
+};
+
+// Same order as RadarToolkit::CFARType.
+enum { RADAR_CFAR_CELL_AVERAGING, RADAR_CFAR_GREATEST_OF, RADAR_CFAR_SMALLEST_OF, RADAR_CFAR_ORDER_STATISTIC };
+
+// Scratch memory and detection lists reused from call to call, so a steady stream of same-sized calls does
+// not allocate. A context must not be used by two threads at once; give each calling thread its own.
+typedef struct radar_context radar_context;
+// A prepared reference spectrum. It is never modified after creation, so any number of threads may share one.
+typedef struct radar_reference radar_reference;
+typedef struct radar_reference_f radar_reference_f;
+
+RADAR_API int radar_api_version(void);
+RADAR_API const char* radar_status_message(int status);
+
+// threads 0 runs on the process-wide pool; otherwise the context owns a pool of that many threads, the
+// calling thread included.
+RADAR_API radar_context* radar_context_create(size_t threads);
+RADAR_API void radar_context_destroy(radar_context* context);
+
+// Linear FM chirp of radar_chirp_length(duration, fs) samples; length must match.
+RADAR_API size_t radar_chirp_length(double duration, double fs);
+RADAR_API int radar_generate_chirp(radar_context* context, double f0, double bandwidth, double duration, double fs,
+                                   double* out, size_t length, ptrdiff_t stride);
+RADAR_API int radar_generate_chirp_f(radar_context* context, double f0, double bandwidth, double duration, double fs,
+                                     float* out, size_t length, ptrdiff_t stride);
+
+// fft_size 0 picks four times the reference length; the window tapers the reference. Returns null on failure.
+RADAR_API radar_reference* radar_reference_create(const double* samples, size_t length, ptrdiff_t stride,
+                                                  size_t fft_size, int window, double window_parameter);
+RADAR_API radar_reference_f* radar_reference_create_f(const float* samples, size_t length, ptrdiff_t stride,
+                                                      size_t fft_size, int window, double window_parameter);
+RADAR_API void radar_reference_destroy(radar_reference* reference);
+RADAR_API void radar_reference_destroy_f(radar_reference_f* reference);
+
+// The first `length` lags of the correlation of the signal with the reference. out may be the signal itself.
+RADAR_API int radar_matched_filter(radar_context* context, const radar_reference* reference, const double* signal,
+                                   ptrdiff_t signal_stride, double* out, ptrdiff_t out_stride, size_t length);
+RADAR_API int radar_matched_filter_f(radar_context* context, const radar_reference_f* reference, const float* signal,
+                                     ptrdiff_t signal_stride, float* out, ptrdiff_t out_stride, size_t length);
+
+// A CPI is num_pulses rows of num_samples contiguous samples, pulse_stride samples apart (num_samples for a
+// C-ordered array). Its pulses are range-compressed in place.
+RADAR_API int radar_matched_filter_cpi(radar_context* context, const radar_reference* reference, double* pulses,
+                                       size_t num_pulses, size_t num_samples, ptrdiff_t pulse_stride);
+RADAR_API int radar_matched_filter_cpi_f(radar_context* context, const radar_reference_f* reference, float* pulses,
+                                         size_t num_pulses, size_t num_samples, ptrdiff_t pulse_stride);
+
+// Windowed slow-time FFT magnitudes of a CPI into num_samples * num_pulses values, one row per range bin with
+// zero velocity at column num_pulses / 2, as RangeDopplerMap::data holds them.
+RADAR_API int radar_range_doppler(radar_context* context, const double* pulses, size_t num_pulses, size_t num_samples,
+                                  ptrdiff_t pulse_stride, int window, double window_parameter, double* magnitudes);
+RADAR_API int radar_range_doppler_f(radar_context* context, const float* pulses, size_t num_pulses, size_t num_samples,
+                                    ptrdiff_t pulse_stride, int window, double window_parameter, float* magnitudes);
+
+// The CFAR functions return the number of detections, or a negative status. Up to `capacity` of them are
+// written in ascending (range-major) order; when more were found, call again with a larger buffer.
+RADAR_API ptrdiff_t radar_cfar(radar_context* context, const double* signal, size_t length, ptrdiff_t stride,
+                               size_t guard_cells, size_t training_cells, double pfa, int type, size_t os_rank,
+                               size_t* detections, size_t capacity);
+RADAR_API ptrdiff_t radar_cfar_f(radar_context* context, const float* signal, size_t length, ptrdiff_t stride,
+                                 size_t guard_cells, size_t training_cells, double pfa, int type, size_t os_rank,
+                                 size_t* detections, size_t capacity);
+// Cell-averaging CFAR over a magnitude map of num_range_bins rows of num_doppler_bins contiguous values.
+RADAR_API ptrdiff_t radar_cfar_2d(radar_context* context, const double* magnitudes, size_t num_range_bins,
+                                  size_t num_doppler_bins, size_t guard_range, size_t guard_doppler,
+                                  size_t training_range, size_t training_doppler, double pfa, size_t* range_bins,
+                                  size_t* doppler_bins, size_t capacity);
+RADAR_API ptrdiff_t radar_cfar_2d_f(radar_context* context, const float* magnitudes, size_t num_range_bins,
+                                    size_t num_doppler_bins, size_t guard_range, size_t guard_doppler,
+                                    size_t training_range, size_t training_doppler, double pfa, size_t* range_bins,
+                                    size_t* doppler_bins, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
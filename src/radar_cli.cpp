@@ -3,14 +3,27 @@
 #include "signal_processor.h"
 #include "signal_analyzer.h"
 #include "file_io.h"
+#include "stream_pipeline.h"
+#include "target_extractor.h"
+#include "waveform_library.h"
 #include "test_suite.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <limits>
+#include <algorithm>
 
 namespace RadarToolkit {
 
+SceneConfig RadarCLI::sceneConfig() const {
+    SceneConfig config;
+    config.f0 = f0;
+    config.fs = fs;
+    config.prf = prf;
+    config.num_pulses = num_pulses;
+    return config;
+}
+
 void RadarCLI::clearInputBuffer() {
     std::cin.clear();
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -43,16 +56,33 @@ void RadarCLI::run() {
 
         switch (choice) {
             case 1:
-                signal = SignalGenerator::generateChirp(f0, bandwidth, duration, fs);
-                reference = signal;
-                pulse_train = std::vector<std::vector<std::complex<double>>>(num_pulses, signal);
+                {
+                    auto waveform = WaveformLibrary::get({WaveformType::LFM, f0, bandwidth, duration, fs}, range_window);
+                    signal = waveform->samples;
+                    reference = signal;
+                    reference_spectrum = waveform->spectrum;
+                }
+                SceneSimulator::simulate(signal, targets, sceneConfig(), pulse_train);
                 std::cout << "Chirp signal generated.\n";
                 SignalAnalyzer::displayStats(signal);
                 break;
             case 2:
-                signal = SignalGenerator::generateBarkerCode(barker_length, fs);
-                reference = signal;
-                pulse_train = std::vector<std::vector<std::complex<double>>>(num_pulses, signal);
+                {
+                    WaveformParams params;
+                    params.type = WaveformType::Barker;
+                    params.fs = fs;
+                    params.code_length = barker_length;
+                    params.chip_rate = bandwidth;
+                    auto waveform = WaveformLibrary::get(params, range_window);
+                    signal = waveform->samples;
+                    reference = signal;
+                    reference_spectrum = waveform->spectrum;
+                }
+                if (signal.empty()) {
+                    std::cout << "Unsupported Barker length " << barker_length << ".\n";
+                    break;
+                }
+                SceneSimulator::simulate(signal, targets, sceneConfig(), pulse_train);
                 std::cout << "Barker code generated.\n";
                 SignalAnalyzer::displayStats(signal);
                 break;
@@ -62,7 +92,7 @@ void RadarCLI::run() {
                     break;
                 }
                 SignalGenerator::addNoise(signal, snr_db);
-                for (auto& pulse : pulse_train) SignalGenerator::addNoise(pulse, snr_db);
+                SignalGenerator::addNoise(pulse_train.samples(), snr_db);
                 std::cout << "Noise added (SNR: " << snr_db << " dB).\n";
                 SignalAnalyzer::displayStats(signal);
                 break;
@@ -71,8 +101,8 @@ void RadarCLI::run() {
                     std::cout << "Generate a signal first!\n";
                     break;
                 }
-                SignalGenerator::addClutter(signal, cnr_db);
-                for (auto& pulse : pulse_train) SignalGenerator::addClutter(pulse, cnr_db);
+                ClutterGenerator::addClutter(signal, cnr_db, clutter_model, RandomStream::next());
+                ClutterGenerator::addClutter(pulse_train, cnr_db, clutter_model, prf);
                 std::cout << "Clutter added (CNR: " << cnr_db << " dB).\n";
                 SignalAnalyzer::displayStats(signal);
                 break;
@@ -81,8 +111,8 @@ void RadarCLI::run() {
                     std::cout << "Generate a signal first!\n";
                     break;
                 }
-                signal = SignalProcessor::matchedFilter(signal, reference);
-                for (auto& pulse : pulse_train) pulse = SignalProcessor::matchedFilter(pulse, reference);
+                signal = SignalProcessor::matchedFilter(signal, reference_spectrum);
+                SignalProcessor::matchedFilter(pulse_train, reference_spectrum);
                 std::cout << "Matched filter applied.\n";
                 SignalAnalyzer::displayStats(signal);
                 break;
@@ -92,10 +122,14 @@ void RadarCLI::run() {
                     break;
                 }
                 {
-                    auto detections = SignalProcessor::cfarDetection(signal, guard_cells, training_cells, pfa);
-                    std::cout << "CFAR detections at indices: ";
-                    for (const auto& idx : detections) std::cout << idx << " ";
-                    std::cout << "\n";
+                    auto detections = SignalProcessor::cfarDetection(signal, guard_cells, training_cells, pfa, cfar_type);
+                    TargetExtractor extractor;
+                    auto reports = extractor.extract(signal, detections, 3.0e8 / (2.0 * fs));
+                    std::cout << "CFAR: " << detections.size() << " detections, " << reports.size() << " targets\n";
+                    for (const auto& target : reports) {
+                        std::cout << "  index " << target.range_bin << " range " << target.range << " m, SNR "
+                                  << target.snr_db << " dB, " << target.cells << " cells\n";
+                    }
                 }
                 break;
             case 7:
@@ -118,8 +152,13 @@ void RadarCLI::run() {
                     break;
                 }
                 {
-                    auto map = SignalProcessor::rangeDopplerMap(pulse_train, f0, fs);
+                    auto map = SignalProcessor::rangeDopplerMap(pulse_train, f0, fs, prf, doppler_window);
                     SignalAnalyzer::displayRangeDopplerMap(map);
+                    const WindowLoss& range_loss = reference_spectrum.window_loss;
+                    const WindowLoss& doppler_loss = map.doppler_window_loss;
+                    std::cout << "Window loss (range / Doppler): processing " << range_loss.processing_loss_db << " / "
+                              << doppler_loss.processing_loss_db << " dB, scalloping " << range_loss.scalloping_loss_db
+                              << " / " << doppler_loss.scalloping_loss_db << " dB\n";
                 }
                 break;
             case 9:
@@ -145,7 +184,18 @@ void RadarCLI::run() {
                     std::string filename;
                     std::cout << "Enter filename to save: ";
                     std::getline(std::cin, filename);
-                    if (FileIO::saveSignal(signal, filename)) {
+                    bool saved;
+                    if (FileIO::isBinaryFile(filename)) {
+                        IQFileHeader metadata;
+                        metadata.fs = fs;
+                        metadata.f0 = f0;
+                        metadata.bandwidth = bandwidth;
+                        metadata.prf = prf;
+                        saved = FileIO::saveBinary(signal, filename, metadata);
+                    } else {
+                        saved = FileIO::saveSignal(signal, filename);
+                    }
+                    if (saved) {
                         std::cout << "Signal saved to " << filename << "\n";
                     } else {
                         std::cout << "Failed to save signal.\n";
@@ -157,10 +207,23 @@ void RadarCLI::run() {
                     std::string filename;
                     std::cout << "Enter filename to load: ";
                     std::getline(std::cin, filename);
-                    signal = FileIO::loadSignal(filename);
+                    if (FileIO::isBinaryFile(filename)) {
+                        IQFileHeader metadata;
+                        if (FileIO::loadBinary(filename, pulse_train, &metadata) && !pulse_train.empty()) {
+                            signal.assign(pulse_train.row(0).begin(), pulse_train.row(0).end());
+                            if (metadata.fs > 0.0) fs = metadata.fs;
+                            if (metadata.f0 > 0.0) f0 = metadata.f0;
+                            if (metadata.prf > 0.0) prf = metadata.prf;
+                        } else {
+                            signal.clear();
+                        }
+                    } else {
+                        signal = FileIO::loadSignal(filename);
+                        if (!signal.empty()) SceneSimulator::simulate(signal, targets, sceneConfig(), pulse_train);
+                    }
                     if (!signal.empty()) {
                         reference = signal;
-                        pulse_train = std::vector<std::vector<std::complex<double>>>(num_pulses, signal);
+                        reference_spectrum = SignalProcessor::prepareReference(reference, 0, range_window);
                         std::cout << "Signal loaded from " << filename << "\n";
                     } else {
                         std::cout << "Failed to load signal.\n";
@@ -186,10 +249,49 @@ void RadarCLI::run() {
                 std::cin >> training_cells;
                 std::cout << "Enter probability of false alarm: ";
                 std::cin >> pfa;
-                std::cout << "Enter Barker code length (7 or 13): ";
+                {
+                    int type;
+                    std::cout << "Enter CFAR type (0=CA, 1=GO, 2=SO, 3=OS): ";
+                    std::cin >> type;
+                    cfar_type = static_cast<CFARType>(std::clamp(type, 0, 3));
+                }
+                std::cout << "Enter Barker code length (2, 3, 4, 5, 7, 11 or 13): ";
                 std::cin >> barker_length;
                 std::cout << "Enter number of pulses for Doppler: ";
                 std::cin >> num_pulses;
+                std::cout << "Enter pulse repetition frequency (Hz): ";
+                std::cin >> prf;
+                {
+                    size_t count;
+                    std::cout << "Enter number of targets: ";
+                    std::cin >> count;
+                    targets.resize(count);
+                    for (size_t i = 0; i < count; ++i) {
+                        std::cout << "Enter target " << i + 1 << " range (m), velocity (m/s) and RCS (m^2): ";
+                        std::cin >> targets[i].range >> targets[i].velocity >> targets[i].rcs;
+                    }
+                }
+                {
+                    int model;
+                    std::cout << "Enter clutter model (0=Rayleigh, 1=K, 2=Weibull, 3=log-normal): ";
+                    std::cin >> model;
+                    clutter_model.amplitude = static_cast<ClutterAmplitude>(std::clamp(model, 0, 3));
+                }
+                std::cout << "Enter clutter shape parameter: ";
+                std::cin >> clutter_model.shape;
+                std::cout << "Enter clutter Doppler spread (Hz, 0 for white): ";
+                std::cin >> clutter_model.doppler_spread;
+                clutter_model.spectrum = clutter_model.doppler_spread > 0 ? ClutterSpectrum::Gaussian : ClutterSpectrum::White;
+                {
+                    int range_type, doppler_type;
+                    std::cout << "Enter range and Doppler windows (0=none, 1=Hann, 2=Hamming, 3=Blackman-Harris, "
+                                 "4=Taylor, 5=Chebyshev, 6=Kaiser): ";
+                    std::cin >> range_type >> doppler_type;
+                    range_window.type = static_cast<WindowType>(std::clamp(range_type, 0, 6));
+                    doppler_window.type = static_cast<WindowType>(std::clamp(doppler_type, 0, 6));
+                }
+                std::cout << "Use single precision for batch runs (0/1): ";
+                std::cin >> single_precision;
                 clearInputBuffer();
                 std::cout << "Parameters updated.\n";
                 break;
@@ -213,40 +315,161 @@ void RadarCLI::run() {
     }
 }
 
-void RadarCLI::runBatch(const std::string& config_file) {
+GraphConfig RadarCLI::graphConfig() const {
+    GraphConfig config;
+    config.waveform = {WaveformType::LFM, f0, bandwidth, duration, fs};
+    config.prf = prf;
+    config.num_pulses = num_pulses;
+    config.targets = targets;
+    config.clutter_model = clutter_model;
+    config.range_window = range_window;
+    config.doppler_window = doppler_window;
+    config.cfar_type = cfar_type;
+    config.guard_cells = guard_cells;
+    config.training_cells = training_cells;
+    config.pfa = pfa;
+    config.scenarios = {{snr_db, cnr_db}};
+    config.single_precision = single_precision;
+    config.jobs = jobs;
+    config.seed = seed;
+    return config;
+}
+
+bool RadarCLI::loadGraph(const std::string& config_file, GraphConfig& config) {
     std::ifstream file(config_file);
     if (!file.is_open()) {
         std::cout << "Failed to open config file: " << config_file << "\n";
-        return;
+        return false;
     }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
 
-    std::string line;
-    int run_count = 0;
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        double batch_snr, batch_cnr;
-        ss >> batch_snr >> batch_cnr;
-
-        signal = SignalGenerator::generateChirp(f0, bandwidth, duration, fs);
-        reference = signal;
-        pulse_train = std::vector<std::vector<std::complex<double>>>(num_pulses, signal);
+    config = graphConfig();
+    std::string error;
+    size_t first = text.find_first_not_of(" \t\r\n");
+    bool graph = first != std::string::npos && (text[first] == '{' || text[first] == '[' || text[first] == '#' ||
+                                                text[first] == ';' || text.find('=') != std::string::npos);
+    if (graph) {
+        if (!ProcessingGraph::parse(text, config, error)) {
+            std::cout << config_file << ": " << error << "\n";
+            return false;
+        }
+    } else {
+        // Legacy batch file: SNR and CNR per line through the fixed chain, one CSV per scenario.
+        config.scenarios.clear();
+        std::stringstream lines(text);
+        std::string line;
+        while (std::getline(lines, line)) {
+            std::stringstream ss(line);
+            double batch_snr, batch_cnr;
+            if (ss >> batch_snr >> batch_cnr) config.scenarios.push_back({batch_snr, batch_cnr});
+        }
+        config.output = GraphOutput::CSV;
+    }
+    if (precision_set) config.single_precision = single_precision;
+    if (jobs_set) config.jobs = jobs;
+    if (seed_set) config.seed = seed;
+    if (!ProcessingGraph::validate(config, error)) {
+        std::cout << config_file << ": " << error << "\n";
+        return false;
+    }
+    return true;
+}
 
-        SignalGenerator::addNoise(signal, batch_snr);
-        for (auto& pulse : pulse_train) SignalGenerator::addNoise(pulse, batch_snr);
+bool RadarCLI::runBatch(const std::string& config_file) {
+    GraphConfig config;
+    if (!loadGraph(config_file, config)) return false;
+    if (config.single_precision) runGraph<float>(config);
+    else runGraph<double>(config);
+    return true;
+}
 
-        SignalGenerator::addClutter(signal, batch_cnr);
-        for (auto& pulse : pulse_train) SignalGenerator::addClutter(pulse, batch_cnr);
+bool RadarCLI::printPlan(const std::string& config_file) {
+    GraphConfig config;
+    if (!loadGraph(config_file, config)) return false;
+    GraphRunner runner(config);
+    std::cout << ProcessingGraph::describe(runner.steps()) << "\n"
+              << config.scenarios.size() << " scenarios, " << config.num_pulses << " x " << runner.samplesPerPulse()
+              << " CPI, " << (config.single_precision ? "float" : "double") << "\n";
+    return true;
+}
 
-        signal = SignalProcessor::matchedFilter(signal, reference);
-        for (auto& pulse : pulse_train) pulse = SignalProcessor::matchedFilter(pulse, reference);
+template <typename T>
+void RadarCLI::runGraph(const GraphConfig& config) {
+    BasicGraphRunner<T> runner(config);
+    runner.run([&](size_t index, const GraphResult& result) {
+        if (config.output == GraphOutput::CSV) {
+            std::cout << "Batch run " << index + 1 << " completed. Results saved to " << result.output_file << "\n";
+        } else if (config.output == GraphOutput::Summary) {
+            const GraphScenario& scenario = config.scenarios[index];
+            std::cout << "scenario " << index + 1 << " snr " << scenario.snr_db << " cnr " << scenario.cnr_db
+                      << ": " << result.range_detections << " range detections, " << result.detections.size()
+                      << " range-Doppler targets\n";
+            for (const auto& hit : result.detections) {
+                std::cout << "  range " << hit.range << " velocity " << hit.velocity << " snr " << hit.snr_db << "\n";
+            }
+        }
+    });
+}
 
-        auto detections = SignalProcessor::cfarDetection(signal, guard_cells, training_cells, pfa);
-        auto map = SignalProcessor::rangeDopplerMap(pulse_train, f0, fs);
+bool RadarCLI::runStream(const std::string& source) {
+    IQStreamReader reader;
+    if (!reader.open(source)) {
+        std::cerr << "Failed to open IQ stream: " << source << "\n";
+        return false;
+    }
+    return single_precision ? runStreamPipeline<float>(reader) : runStreamPipeline<double>(reader);
+}
 
-        std::string output_file = "batch_result_" + std::to_string(run_count++) + ".csv";
-        FileIO::saveSignal(signal, output_file);
-        std::cout << "Batch run " << run_count << " completed. Results saved to " << output_file << "\n";
+template <typename T>
+bool RadarCLI::runStreamPipeline(IQStreamReader& reader) {
+    const IQFileHeader& header = reader.header();
+    StreamConfig config;
+    config.f0 = header.f0 > 0 ? header.f0 : f0;
+    config.fs = header.fs > 0 ? header.fs : fs;
+    config.prf = header.prf > 0 ? header.prf : prf;
+    if (!(config.fs > 0.0 && config.prf > 0.0)) {
+        std::cerr << "Stream needs a positive sample rate and PRF\n";
+        return false;
     }
+    config.samples_per_pulse = header.samples_per_pulse
+        ? header.samples_per_pulse : static_cast<size_t>(config.fs / config.prf);
+    config.pulses_per_cpi = header.pulses_per_cpi ? header.pulses_per_cpi : num_pulses;
+    if (config.samples_per_pulse == 0 || config.pulses_per_cpi == 0) {
+        std::cerr << "Stream needs a sample rate of at least the PRF and at least one pulse per CPI\n";
+        return false;
+    }
+    config.guard_cells = guard_cells;
+    config.training_cells = training_cells;
+    config.pfa = pfa;
+    config.cfar_type = cfar_type;
+    config.range_window = range_window;
+    config.doppler_window = doppler_window;
+
+    double stream_bandwidth = header.bandwidth > 0 ? header.bandwidth : bandwidth;
+    auto stream_reference = BasicSignalGenerator<T>::generateChirp(config.f0, stream_bandwidth, duration, config.fs);
+    BasicStreamPipeline<T> pipeline(stream_reference, config);
+
+    pipeline.onDetections([](std::span<const uint64_t> hits) {
+        for (uint64_t index : hits) std::cout << "detection " << index << "\n";
+    });
+    BasicTargetExtractor<T> extractor;
+    pipeline.onCPI([&](const BasicRangeDopplerMap<T>& map, const std::vector<Detection2D>& hits, uint64_t index) {
+        for (const auto& target : extractor.extract(map, hits)) {
+            std::cout << "cpi " << index << " range " << target.range << " velocity " << target.velocity
+                      << " snr " << target.snr_db << "\n";
+        }
+    });
+    bool complete = pipeline.run(reader);
+
+    const StreamStats& stats = pipeline.stats();
+    std::cerr << "Streamed " << stats.samples << " samples in " << stats.blocks << " blocks, "
+              << stats.detections << " detections, " << stats.cpis << " CPIs; block latency mean "
+              << (stats.blocks ? stats.total_seconds / stats.blocks * 1e3 : 0.0) << " ms, max "
+              << stats.max_block_seconds * 1e3 << " ms\n";
+    if (!complete) std::cerr << "IQ stream ended early or failed to read\n";
+    return complete;
 }
 
 }
\ No newline at end of file
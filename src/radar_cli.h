@@ -2,13 +2,30 @@
 #include <vector>
 #include <complex>
 #include <string>
+#include <cstdint>
+#include "signal_processor.h"
+#include "pulse_matrix.h"
+#include "file_io.h"
+#include "random.h"
+#include "clutter_model.h"
+#include "scene_simulator.h"
+#include "processing_graph.h"
 
 namespace RadarToolkit {
 
 class RadarCLI {
 public:
     void run();
-    void runBatch(const std::string& config_file);
+    // Accepts an INI/JSON processing graph or the legacy one-scenario-per-line SNR/CNR file.
+    bool runBatch(const std::string& config_file);
+    bool runStream(const std::string& source);
+    // Prints the validated, fused stage plan of a graph config without running it.
+    bool printPlan(const std::string& config_file);
+    // Flags set here take precedence over the same settings in a graph config.
+    void setSinglePrecision(bool enabled) { single_precision = enabled; precision_set = true; }
+    // Batch worker threads (0 = all hardware threads) and master seed for per-scenario noise.
+    void setJobs(size_t count) { jobs = count; jobs_set = true; }
+    void setSeed(uint64_t value) { seed = value; seed_set = true; RandomStream::setMasterSeed(value); }
 
 private:
     double f0 = 1e9;
@@ -20,13 +37,31 @@ private:
     size_t guard_cells = 5;
     size_t training_cells = 10;
     double pfa = 1e-6;
+    CFARType cfar_type = CFARType::CellAveraging;
     int barker_length = 7;
     size_t num_pulses = 10;
+    double prf = 10e3;
+    ClutterModel clutter_model;
+    WindowSpec range_window;
+    WindowSpec doppler_window{WindowType::Hann};
+    std::vector<Target> targets = {Target{}};
+    bool single_precision = false;
+    size_t jobs = 0;
+    uint64_t seed = 1;
+    bool precision_set = false;
+    bool jobs_set = false;
+    bool seed_set = false;
     std::vector<std::complex<double>> signal;
     std::vector<std::complex<double>> reference;
-    std::vector<std::vector<std::complex<double>>> pulse_train;
+    ReferenceSpectrum reference_spectrum;
+    PulseMatrix pulse_train;
 
     void clearInputBuffer();
+    SceneConfig sceneConfig() const;
+    GraphConfig graphConfig() const;
+    bool loadGraph(const std::string& config_file, GraphConfig& config);
+    template <typename T> void runGraph(const GraphConfig& config);
+    template <typename T> bool runStreamPipeline(IQStreamReader& reader);
 };
 
 }
\ No newline at end of file
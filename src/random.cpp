@@ -0,0 +1,141 @@
+#include "random.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace RadarToolkit {
+
+constexpr double TWO_PI = 6.28318530717958647692;
+// Values are produced in tiles so the generator, conversion and Box-Muller passes each run as
+// straight-line loops over small arrays.
+constexpr size_t TILE = 256;
+
+static std::atomic<uint64_t> master_seed{0x5EEDULL};
+static std::atomic<uint64_t> next_stream{0};
+
+static uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+Philox4x32::Block Philox4x32::generate(Block counter, uint64_t key) {
+    uint32_t k0 = static_cast<uint32_t>(key);
+    uint32_t k1 = static_cast<uint32_t>(key >> 32);
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = uint64_t(0xD2511F53u) * counter[0];
+        uint64_t p1 = uint64_t(0xCD9E8D57u) * counter[2];
+        counter = {static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ k0, static_cast<uint32_t>(p1),
+                   static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ k1, static_cast<uint32_t>(p0)};
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    return counter;
+}
+
+RandomStream RandomStream::split(uint64_t index) const {
+    return RandomStream(key, mix64(stream_id + (index + 1) * 0x9E3779B97F4A7C15ULL));
+}
+
+void RandomStream::setMasterSeed(uint64_t seed) {
+    master_seed = seed;
+    next_stream = 0;
+}
+
+RandomStream RandomStream::next() {
+    return RandomStream(master_seed.load()).split(next_stream.fetch_add(1));
+}
+
+// Writes 32-bit words [first_word, first_word + count) of the stream.
+static void generateWords(uint64_t key, uint64_t stream, uint64_t first_word, size_t count, uint32_t* words) {
+    uint64_t block = first_word / 4;
+    size_t skip = first_word % 4;
+    size_t written = 0;
+    while (written < count) {
+        auto out = Philox4x32::generate({static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32),
+                                         static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)}, key);
+        for (size_t lane = skip; lane < 4 && written < count; ++lane) words[written++] = out[lane];
+        skip = 0;
+        ++block;
+    }
+}
+
+// Maps a word to (0, 1) at the precision of T, never returning 0 so log() stays finite.
+template <typename T>
+static T toUniform(uint32_t word) {
+    if constexpr (sizeof(T) == sizeof(float)) {
+        return (static_cast<T>(word >> 8) + T(0.5)) * T(1.0 / 16777216.0);
+    } else {
+        return (static_cast<T>(word) + T(0.5)) * T(1.0 / 4294967296.0);
+    }
+}
+
+template <typename T>
+void RandomStream::fillUniform(std::span<T> out, uint64_t offset) const {
+    uint32_t words[TILE];
+    for (size_t start = 0; start < out.size(); start += TILE) {
+        size_t n = std::min(TILE, out.size() - start);
+        generateWords(key, stream_id, offset + start, n, words);
+        for (size_t i = 0; i < n; ++i) out[start + i] = toUniform<T>(words[i]);
+    }
+}
+
+template <typename T>
+void RandomStream::gaussianPairs(uint64_t first_pair, size_t count, T* cos_part, T* sin_part) const {
+    uint32_t words[2 * TILE];
+    T radius[TILE];
+    T angle[TILE];
+    for (size_t start = 0; start < count; start += TILE) {
+        size_t n = std::min(TILE, count - start);
+        generateWords(key, stream_id, 2 * (first_pair + start), 2 * n, words);
+        for (size_t i = 0; i < n; ++i) {
+            radius[i] = std::sqrt(T(-2) * std::log(toUniform<T>(words[2 * i])));
+            angle[i] = static_cast<T>(TWO_PI) * toUniform<T>(words[2 * i + 1]);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            cos_part[start + i] = radius[i] * std::cos(angle[i]);
+            sin_part[start + i] = radius[i] * std::sin(angle[i]);
+        }
+    }
+}
+
+template <typename T>
+void RandomStream::fillGaussian(std::span<T> out, T stddev, uint64_t offset) const {
+    T cos_part[TILE];
+    T sin_part[TILE];
+    uint64_t pair = offset / 2;
+    bool skip = offset % 2;
+    for (size_t produced = 0; produced < out.size();) {
+        size_t pairs = std::min(TILE, (out.size() - produced + skip + 1) / 2);
+        gaussianPairs(pair, pairs, cos_part, sin_part);
+        for (size_t p = 0; p < pairs; ++p) {
+            if (!skip && produced < out.size()) out[produced++] = stddev * cos_part[p];
+            skip = false;
+            if (produced < out.size()) out[produced++] = stddev * sin_part[p];
+        }
+        pair += pairs;
+    }
+}
+
+template <typename T>
+void RandomStream::addComplexGaussian(std::span<std::complex<T>> out, T stddev, uint64_t offset) const {
+    T real_part[TILE];
+    T imag_part[TILE];
+    std::complex<T> noise[TILE];
+    for (size_t start = 0; start < out.size(); start += TILE) {
+        size_t n = std::min(TILE, out.size() - start);
+        gaussianPairs(offset + start, n, real_part, imag_part);
+        for (size_t i = 0; i < n; ++i) noise[i] = {real_part[i], imag_part[i]};
+        BasicSIMDKernels<T>::scaledAdd(std::span<const std::complex<T>>(noise, n), stddev, out.subspan(start, n));
+    }
+}
+
+template void RandomStream::fillUniform<float>(std::span<float>, uint64_t) const;
+template void RandomStream::fillUniform<double>(std::span<double>, uint64_t) const;
+template void RandomStream::fillGaussian<float>(std::span<float>, float, uint64_t) const;
+template void RandomStream::fillGaussian<double>(std::span<double>, double, uint64_t) const;
+template void RandomStream::addComplexGaussian<float>(std::span<std::complex<float>>, float, uint64_t) const;
+template void RandomStream::addComplexGaussian<double>(std::span<std::complex<double>>, double, uint64_t) const;
+
+}
\ No newline at end of file
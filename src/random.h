@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <span>
+
+namespace RadarToolkit {
+
+// Philox4x32-10 counter-based generator (Salmon et al., SC'11). The output depends only on
+// (counter, key), so any block of any stream can be produced independently, in any order, on any thread.
+class Philox4x32 {
+public:
+    using Block = std::array<uint32_t, 4>;
+    static Block generate(Block counter, uint64_t key);
+};
+
+// A reproducible random sequence addressed by position: (seed, stream, offset) always yields the same
+// values, so buffers can be filled in parallel chunks without changing the result.
+class RandomStream {
+public:
+    explicit RandomStream(uint64_t seed = 0, uint64_t stream = 0) : key(seed), stream_id(stream) {}
+
+    // Independent child stream, e.g. per scenario, pulse or thread.
+    RandomStream split(uint64_t index) const;
+    uint64_t seed() const { return key; }
+    uint64_t stream() const { return stream_id; }
+
+    // Uniform values in (0, 1), one 32-bit draw per value.
+    template <typename T> void fillUniform(std::span<T> out, uint64_t offset = 0) const;
+    // Zero-mean normal values; offset counts values from the start of the stream.
+    template <typename T> void fillGaussian(std::span<T> out, T stddev, uint64_t offset = 0) const;
+    // Adds circular complex Gaussian noise with per-component deviation stddev; offset counts complex samples.
+    template <typename T> void addComplexGaussian(std::span<std::complex<T>> out, T stddev, uint64_t offset = 0) const;
+
+    static void setMasterSeed(uint64_t seed);
+    // Successive streams of the master seed, for callers that do not manage seeds themselves.
+    static RandomStream next();
+
+private:
+    uint64_t key;
+    uint64_t stream_id;
+
+    template <typename T> void gaussianPairs(uint64_t first_pair, size_t count, T* cos_part, T* sin_part) const;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "scene_simulator.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace RadarToolkit {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double C = 3.0e8;
+
+static size_t delaySamples(const Target& target, double fs) {
+    return static_cast<size_t>(std::llround(std::max(0.0, 2.0 * target.range / C * fs)));
+}
+
+template <typename T>
+size_t BasicSceneSimulator<T>::receiveWindow(size_t waveform_size, std::span<const Target> targets,
+                                             const SceneConfig& config) {
+    if (config.samples_per_pulse) return config.samples_per_pulse;
+    size_t farthest = 0;
+    for (const auto& target : targets) farthest = std::max(farthest, delaySamples(target, config.fs));
+    size_t window = farthest + waveform_size;
+    if (config.prf > 0.0) window = std::min(window, static_cast<size_t>(config.fs / config.prf));
+    return std::max<size_t>(window, 1);
+}
+
+template <typename T>
+void BasicSceneSimulator<T>::simulate(std::span<const std::complex<T>> waveform, std::span<const Target> targets,
+                                      const SceneConfig& config, BasicPulseMatrix<T>& cpi) {
+    size_t window = receiveWindow(waveform.size(), targets, config);
+    cpi.resize(config.num_pulses, window);
+    cpi.fill(std::complex<T>(0));
+
+    // Per target: the waveform with its fast-time Doppler rotation applied once, so each pulse only needs a
+    // single complex weight for range phase, slow-time Doppler and amplitude.
+    struct Echo {
+        size_t delay;
+        size_t length;
+        double doppler;
+        double range_phase;
+        double amplitude;
+        std::vector<std::complex<T>> samples;
+    };
+    std::vector<Echo> echoes;
+    for (const auto& target : targets) {
+        size_t delay = delaySamples(target, config.fs);
+        if (delay >= window || waveform.empty()) continue;
+        double doppler = 2.0 * target.velocity * config.f0 / C;
+        echoes.push_back({delay, std::min(waveform.size(), window - delay), doppler,
+                          -2.0 * PI * config.f0 * (2.0 * target.range / C), std::sqrt(std::max(target.rcs, 0.0)), {}});
+    }
+
+    ThreadPool::shared().parallelFor(echoes.size(), [&](size_t begin, size_t end) {
+        for (size_t e = begin; e < end; ++e) {
+            Echo& echo = echoes[e];
+            echo.samples.resize(echo.length);
+            double step = 2.0 * PI * echo.doppler / config.fs;
+            std::complex<double> rotator(1.0, 0.0);
+            std::complex<double> increment(std::cos(step), std::sin(step));
+            for (size_t m = 0; m < echo.length; ++m) {
+                echo.samples[m] = waveform[m] * std::complex<T>(rotator);
+                rotator *= increment;
+                // Renormalize now and then so the recurrence does not drift on long waveforms.
+                if ((m & 1023) == 1023) rotator /= std::abs(rotator);
+            }
+        }
+    });
+
+    ThreadPool::shared().parallelFor(config.num_pulses, [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            auto row = cpi.row(p);
+            double pulse_time = config.prf > 0.0 ? p / config.prf : 0.0;
+            for (const auto& echo : echoes) {
+                double phase = echo.range_phase + 2.0 * PI * echo.doppler * (pulse_time + echo.delay / config.fs);
+                std::complex<T> weight(static_cast<T>(echo.amplitude * std::cos(phase)),
+                                       static_cast<T>(echo.amplitude * std::sin(phase)));
+                std::complex<T>* out = row.data() + echo.delay;
+                for (size_t m = 0; m < echo.length; ++m) out[m] += weight * echo.samples[m];
+            }
+        }
+    });
+}
+
+template class BasicSceneSimulator<float>;
+template class BasicSceneSimulator<double>;
+
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+#include <complex>
+#include <span>
+#include "pulse_matrix.h"
+
+namespace RadarToolkit {
+
+struct Target {
+    double range = 0.0;     // m
+    double velocity = 0.0;  // m/s, positive gives a positive Doppler shift
+    double rcs = 1.0;       // m^2, sets the echo amplitude to sqrt(rcs)
+};
+
+struct SceneConfig {
+    double f0 = 1e9;
+    double fs = 1e9;
+    double prf = 10e3;
+    size_t num_pulses = 10;
+    // Receive window per pulse; 0 sizes it to hold the farthest echo, capped at the unambiguous range fs / prf.
+    size_t samples_per_pulse = 0;
+};
+
+// Synthesizes the baseband echo of a CPI, as in main.py's simulate_received_signal: each target returns the
+// waveform delayed by 2R/c, with carrier phase -2 pi f0 tau and Doppler 2 v f0 / c across fast and slow time.
+// Ranges are held constant over the CPI and delays are rounded to whole samples.
+template <typename T>
+class BasicSceneSimulator {
+public:
+    static void simulate(std::span<const std::complex<T>> waveform, std::span<const Target> targets,
+                         const SceneConfig& config, BasicPulseMatrix<T>& cpi);
+    static size_t receiveWindow(size_t waveform_size, std::span<const Target> targets, const SceneConfig& config);
+};
+
+using SceneSimulator = BasicSceneSimulator<double>;
+using SceneSimulatorF = BasicSceneSimulator<float>;
+
+}
\ No newline at end of file
@@ -1,32 +1,269 @@
 #include "signal_analyzer.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
 #include <iostream>
+#include <iomanip>
 #include <algorithm>
 #include <cmath>
-#include <random>
+#include <cstring>
+#include <limits>
 
 namespace RadarToolkit {
 
-void SignalAnalyzer::displayStats(const std::vector<std::complex<double>>& signal) {
-    double power = std::accumulate(signal.begin(), signal.end(), 0.0,
-        [](double sum, const auto& s) { return sum + std::norm(s); }) / signal.size();
-    double peak = std::abs(*std::max_element(signal.begin(), signal.end(),
-        [](const auto& a, const auto& b) { return std::abs(a) < std::abs(b); }));
-    std::cout << "Signal Power: " << power << " W\n";
-    std::cout << "Peak Amplitude: " << peak << "\n";
+// Samples per SIMD power pass; the buffer stays in L1.
+constexpr size_t CHUNK = 1024;
+// computeStats splits the signal into at most this many contiguous parts, merged in order, so the result does
+// not depend on the thread count.
+constexpr size_t STATS_PARTS = 64;
+constexpr size_t STATS_MIN_PART = size_t{1} << 16;
+
+void StreamingStats::reset() {
+    samples = 0;
+    power_sum = 0.0;
+    sum = 0.0;
+    peak_power = -1.0;
+    peak_index = 0;
+    histogram.fill(0);
 }
 
-void SignalAnalyzer::plotWaveform(const std::vector<std::complex<double>>& signal, size_t width, size_t height) {
-    std::vector<double> magnitudes(signal.size());
-    std::transform(signal.begin(), signal.end(), magnitudes.begin(),
-        [](const auto& s) { return std::abs(s); });
-    double max_mag = *std::max_element(magnitudes.begin(), magnitudes.end());
-    if (max_mag == 0) max_mag = 1.0;
+void StreamingStats::push(std::span<const std::complex<double>> block) {
+    std::array<double, CHUNK> power;
+    for (size_t start = 0; start < block.size(); start += CHUNK) {
+        size_t n = std::min(CHUNK, block.size() - start);
+        auto chunk = block.subspan(start, n);
+        SIMDKernels::power(chunk, std::span<double>(power.data(), n));
+        double chunk_power = 0.0;
+        std::complex<double> chunk_sum = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            chunk_power += power[i];
+            chunk_sum += chunk[i];
+            if (power[i] > peak_power) {
+                peak_power = power[i];
+                peak_index = samples + start + i;
+            }
+            // Octave from the exponent bits, sub-bucket from the top four mantissa bits.
+            uint64_t bits;
+            std::memcpy(&bits, &power[i], sizeof(bits));
+            int64_t octave = static_cast<int64_t>(bits >> 52) - 1023 + static_cast<int64_t>(OCTAVES / 2);
+            size_t bucket = octave < 0 ? 0
+                : octave >= static_cast<int64_t>(OCTAVES) ? histogram.size() - 1
+                : static_cast<size_t>(octave) * SUB_BUCKETS + ((bits >> 48) & (SUB_BUCKETS - 1));
+            ++histogram[bucket];
+        }
+        power_sum += chunk_power;
+        sum += chunk_sum;
+    }
+    samples += block.size();
+}
+
+void StreamingStats::merge(const StreamingStats& other) {
+    if (other.peak_power > peak_power) {
+        peak_power = other.peak_power;
+        peak_index = samples + other.peak_index;
+    }
+    samples += other.samples;
+    power_sum += other.power_sum;
+    sum += other.sum;
+    for (size_t i = 0; i < histogram.size(); ++i) histogram[i] += other.histogram[i];
+}
+
+double StreamingStats::percentile(double fraction) const {
+    if (samples == 0) return 0.0;
+    auto rank = static_cast<uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(samples)));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    size_t bucket = 0;
+    for (; bucket + 1 < histogram.size(); ++bucket) {
+        seen += histogram[bucket];
+        if (seen >= rank) break;
+    }
+    if (bucket == 0) return 0.0;
+    double octave = static_cast<double>(bucket / SUB_BUCKETS) - static_cast<double>(OCTAVES / 2);
+    double mantissa = 1.0 + (static_cast<double>(bucket % SUB_BUCKETS) + 0.5) / SUB_BUCKETS;
+    return std::sqrt(std::ldexp(mantissa, static_cast<int>(octave)));
+}
+
+SignalStats StreamingStats::stats() const {
+    SignalStats result;
+    result.count = samples;
+    if (samples == 0) return result;
+    double n = static_cast<double>(samples);
+    result.mean_power = power_sum / n;
+    result.peak = std::sqrt(peak_power);
+    result.peak_index = peak_index;
+    result.mean = sum / n;
+    result.variance = std::max(0.0, result.mean_power - std::norm(result.mean));
+    result.median = percentile(0.5);
+    result.p90 = percentile(0.9);
+    result.p99 = percentile(0.99);
+    return result;
+}
+
+WaveformPyramid::WaveformPyramid(std::span<const std::complex<double>> signal) : signal(signal) {
+    if (signal.empty()) return;
+    size_t blocks = (signal.size() + BASE_BLOCK - 1) / BASE_BLOCK;
+    low.emplace_back(blocks);
+    high.emplace_back(blocks);
+    ThreadPool::shared().parallelFor(blocks, [&](size_t begin, size_t end) {
+        std::array<double, BASE_BLOCK> power;
+        for (size_t b = begin; b < end; ++b) {
+            auto block = signal.subspan(b * BASE_BLOCK, std::min(BASE_BLOCK, signal.size() - b * BASE_BLOCK));
+            SIMDKernels::power(block, std::span<double>(power.data(), block.size()));
+            auto [lo, hi] = std::minmax_element(power.begin(), power.begin() + block.size());
+            low[0][b] = static_cast<float>(*lo);
+            high[0][b] = static_cast<float>(*hi);
+        }
+    }, CHUNK);
+    while (blocks > 1) {
+        const std::vector<float>& finer_low = low.back();
+        const std::vector<float>& finer_high = high.back();
+        blocks = (blocks + 1) / 2;
+        std::vector<float> level_low(blocks), level_high(blocks);
+        for (size_t b = 0; b < blocks; ++b) {
+            size_t last = std::min(2 * b + 1, finer_low.size() - 1);
+            level_low[b] = std::min(finer_low[2 * b], finer_low[last]);
+            level_high[b] = std::max(finer_high[2 * b], finer_high[last]);
+        }
+        low.push_back(std::move(level_low));
+        high.push_back(std::move(level_high));
+    }
+}
+
+void WaveformPyramid::envelope(size_t begin, size_t end, size_t width, std::vector<double>& column_low,
+                               std::vector<double>& column_high) const {
+    end = std::min(end, signal.size());
+    if (begin >= end || width == 0) {
+        column_low.clear();
+        column_high.clear();
+        return;
+    }
+    size_t n = end - begin;
+    size_t columns = std::min(width, n);
+    if (n / columns < BASE_BLOCK) {
+        SignalAnalyzer::envelope(signal.subspan(begin, n), columns, column_low, column_high);
+        return;
+    }
+    size_t level = 0;
+    while (level + 1 < levels() && (BASE_BLOCK << (level + 1)) <= n / columns) ++level;
+    const size_t block = BASE_BLOCK << level;
+    column_low.resize(columns);
+    column_high.resize(columns);
+    for (size_t c = 0; c < columns; ++c) {
+        size_t first = (begin + c * n / columns) / block;
+        size_t last = (begin + (c + 1) * n / columns + block - 1) / block;
+        float lo = std::numeric_limits<float>::max(), hi = 0.0f;
+        for (size_t b = first; b < last; ++b) {
+            lo = std::min(lo, low[level][b]);
+            hi = std::max(hi, high[level][b]);
+        }
+        column_low[c] = std::sqrt(static_cast<double>(lo));
+        column_high[c] = std::sqrt(static_cast<double>(hi));
+    }
+}
 
-    std::vector<std::string> plot(height, std::string(width, ' '));
-    for (size_t i = 0; i < signal.size(); ++i) {
-        size_t col = i * width / signal.size();
-        size_t row = height - 1 - static_cast<size_t>(magnitudes[i] / max_mag * (height - 1));
-        if (row < height) plot[row][col] = '*';
+RangeDopplerPyramid::RangeDopplerPyramid(const RangeDopplerMap& map) : source(map) {
+    const size_t doppler_bins = map.num_doppler_bins;
+    size_t rows = map.num_range_bins;
+    while (rows > 1 && doppler_bins > 0) {
+        size_t coarser = (rows + 1) / 2;
+        std::vector<float> level(coarser * doppler_bins);
+        for (size_t r = 0; r < coarser; ++r) {
+            size_t last = std::min(2 * r + 1, rows - 1);
+            for (size_t d = 0; d < doppler_bins; ++d) {
+                double a = coarse.empty() ? map.at(2 * r, d) : coarse.back()[2 * r * doppler_bins + d];
+                double b = coarse.empty() ? map.at(last, d) : coarse.back()[last * doppler_bins + d];
+                level[r * doppler_bins + d] = static_cast<float>(std::max(a, b));
+            }
+        }
+        coarse.push_back(std::move(level));
+        rows = coarser;
+    }
+}
+
+void RangeDopplerPyramid::render(size_t range_begin, size_t range_end, size_t rows, size_t columns,
+                                 std::vector<double>& cells) const {
+    const size_t doppler_bins = source.num_doppler_bins;
+    range_end = std::min(range_end, source.num_range_bins);
+    if (range_begin >= range_end || doppler_bins == 0 || rows == 0 || columns == 0) {
+        cells.clear();
+        return;
+    }
+    const size_t view = range_end - range_begin;
+    rows = std::min(rows, view);
+    columns = std::min(columns, doppler_bins);
+    size_t level = 0;
+    while (level + 1 < levels() && (view >> (level + 1)) >= rows) ++level;
+    const size_t first = range_begin >> level;
+    const size_t count = ((range_end + (size_t{1} << level) - 1) >> level) - first;
+    cells.assign(rows * columns, 0.0);
+    for (size_t i = 0; i < rows; ++i) {
+        double* out = cells.data() + i * columns;
+        for (size_t r = first + i * count / rows; r < first + (i + 1) * count / rows; ++r) {
+            for (size_t d = 0; d < doppler_bins; ++d) {
+                double value = level == 0 ? source.at(r, d) : coarse[level - 1][r * doppler_bins + d];
+                double& cell = out[d * columns / doppler_bins];
+                cell = std::max(cell, value);
+            }
+        }
+    }
+}
+
+SignalStats SignalAnalyzer::computeStats(std::span<const std::complex<double>> signal) {
+    const size_t n = signal.size();
+    size_t parts = std::clamp<size_t>(n / STATS_MIN_PART, 1, STATS_PARTS);
+    std::vector<StreamingStats> partial(parts);
+    ThreadPool::shared().parallelFor(parts, [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            size_t first = p * n / parts;
+            partial[p].push(signal.subspan(first, (p + 1) * n / parts - first));
+        }
+    });
+    for (size_t p = 1; p < parts; ++p) partial[0].merge(partial[p]);
+    return partial[0].stats();
+}
+
+void SignalAnalyzer::displayStats(std::span<const std::complex<double>> signal) {
+    SignalStats stats = computeStats(signal);
+    std::cout << "Signal Power: " << stats.mean_power << " W\n";
+    std::cout << "Peak Amplitude: " << stats.peak << " at sample " << stats.peak_index << "\n";
+    std::cout << "Mean: " << stats.mean << ", variance " << stats.variance << "\n";
+    std::cout << "Amplitude percentiles (50/90/99%): " << stats.median << " / " << stats.p90 << " / " << stats.p99
+              << "\n";
+}
+
+void SignalAnalyzer::envelope(std::span<const std::complex<double>> signal, size_t width, std::vector<double>& low,
+                              std::vector<double>& high) {
+    const size_t n = signal.size();
+    const size_t columns = std::min(width, n);
+    low.resize(columns);
+    high.resize(columns);
+    ThreadPool::shared().parallelFor(columns, [&](size_t begin, size_t end) {
+        std::array<double, CHUNK> power;
+        for (size_t c = begin; c < end; ++c) {
+            double lo = std::numeric_limits<double>::max(), hi = 0.0;
+            for (size_t start = c * n / columns; start < (c + 1) * n / columns; start += CHUNK) {
+                size_t count = std::min(CHUNK, (c + 1) * n / columns - start);
+                SIMDKernels::power(signal.subspan(start, count), std::span<double>(power.data(), count));
+                auto [min_power, max_power] = std::minmax_element(power.begin(), power.begin() + count);
+                lo = std::min(lo, *min_power);
+                hi = std::max(hi, *max_power);
+            }
+            low[c] = std::sqrt(lo);
+            high[c] = std::sqrt(hi);
+        }
+    });
+}
+
+// Each column is drawn from its smallest to its largest magnitude, so a column of a decimated signal shows every
+// sample that fell into it.
+static void plotEnvelope(const std::vector<double>& low, const std::vector<double>& high, size_t height) {
+    double max_mag = high.empty() ? 0.0 : *std::max_element(high.begin(), high.end());
+    if (max_mag == 0) max_mag = 1.0;
+    std::vector<std::string> plot(height, std::string(low.size(), ' '));
+    for (size_t col = 0; col < low.size() && height > 0; ++col) {
+        size_t top = height - 1 - static_cast<size_t>(high[col] / max_mag * (height - 1));
+        size_t bottom = height - 1 - static_cast<size_t>(low[col] / max_mag * (height - 1));
+        for (size_t row = top; row <= bottom; ++row) plot[row][col] = '*';
     }
 
     std::cout << "Waveform Plot:\n";
@@ -35,14 +272,69 @@ void SignalAnalyzer::plotWaveform(const std::vector<std::complex<double>>& signa
     }
 }
 
-void SignalAnalyzer::displayRangeDopplerMap(const std::vector<std::vector<double>>& map) {
-    std::cout << "Range-Doppler Map (Intensity):\n";
-    for (const auto& range_bin : map) {
-        for (double val : range_bin) {
-            std::cout << (val > 0.5 ? "*" : " ") << " ";
+void SignalAnalyzer::plotWaveform(std::span<const std::complex<double>> signal, size_t width, size_t height) {
+    std::vector<double> low, high;
+    envelope(signal, width, low, high);
+    plotEnvelope(low, high, height);
+}
+
+void SignalAnalyzer::plotWaveform(const WaveformPyramid& pyramid, size_t begin, size_t end, size_t width,
+                                  size_t height) {
+    std::vector<double> low, high;
+    pyramid.envelope(begin, end, width, low, high);
+    plotEnvelope(low, high, height);
+}
+
+void SignalAnalyzer::blockMax(const RangeDopplerMap& map, size_t rows, size_t columns, std::vector<double>& cells) {
+    rows = std::min(rows, map.num_range_bins);
+    columns = std::min(columns, map.num_doppler_bins);
+    cells.assign(rows * columns, 0.0);
+    for (size_t r = 0; r < map.num_range_bins; ++r) {
+        double* out = cells.data() + r * rows / map.num_range_bins * columns;
+        for (size_t d = 0; d < map.num_doppler_bins; ++d) {
+            double& cell = out[d * columns / map.num_doppler_bins];
+            cell = std::max(cell, map.at(r, d));
         }
-        std::cout << "\n";
     }
 }
 
+// Rows are labelled with the range of their first bin.
+static void printMap(const RangeDopplerMap& map, const std::vector<double>& cells, size_t range_begin, size_t view,
+                     size_t columns, double dynamic_range_db) {
+    static constexpr char RAMP[] = " .:-=+*#%@";
+    constexpr size_t STEPS = sizeof(RAMP) - 1;
+    size_t rows = columns ? cells.size() / columns : 0;
+    double peak = cells.empty() ? 0.0 : *std::max_element(cells.begin(), cells.end());
+    std::cout << "Range-Doppler Map (dB below peak, " << dynamic_range_db << " dB shown):\n";
+    for (size_t i = 0; i < rows; ++i) {
+        std::cout << std::setw(10) << map.range(range_begin + i * view / rows) << " m |";
+        for (size_t j = 0; j < columns; ++j) {
+            double value = cells[i * columns + j];
+            double db = value > 0.0 && peak > 0.0 ? 20.0 * std::log10(value / peak) : -dynamic_range_db;
+            double step = (db + dynamic_range_db) / dynamic_range_db * STEPS;
+            std::cout << RAMP[static_cast<size_t>(std::clamp(step, 0.0, STEPS - 1.0))];
+        }
+        std::cout << "|\n";
+    }
+    if (map.num_doppler_bins > 0) {
+        std::cout << "velocity " << map.velocity(0) << " to " << map.velocity(map.num_doppler_bins - 1) << " m/s\n";
+    }
+}
+
+void SignalAnalyzer::displayRangeDopplerMap(const RangeDopplerMap& map, size_t rows, size_t columns,
+                                            double dynamic_range_db) {
+    std::vector<double> cells;
+    blockMax(map, rows, columns, cells);
+    printMap(map, cells, 0, map.num_range_bins, std::min(columns, map.num_doppler_bins), dynamic_range_db);
+}
+
+void SignalAnalyzer::displayRangeDopplerMap(const RangeDopplerPyramid& pyramid, size_t range_begin, size_t range_end,
+                                            size_t rows, size_t columns, double dynamic_range_db) {
+    std::vector<double> cells;
+    pyramid.render(range_begin, range_end, rows, columns, cells);
+    range_end = std::min(range_end, pyramid.map().num_range_bins);
+    printMap(pyramid.map(), cells, range_begin, range_end > range_begin ? range_end - range_begin : 0,
+             std::min(columns, pyramid.map().num_doppler_bins), dynamic_range_db);
+}
+
 }
\ No newline at end of file
@@ -1,14 +1,112 @@
 #pragma once
 #include <vector>
 #include <complex>
+#include <span>
+#include <array>
+#include <cstdint>
+#include "signal_processor.h"
 
 namespace RadarToolkit {
 
+struct SignalStats {
+    size_t count = 0;
+    double mean_power = 0.0;
+    double peak = 0.0;
+    size_t peak_index = 0;
+    std::complex<double> mean;
+    // E|x - mean|^2
+    double variance = 0.0;
+    // Magnitude percentiles.
+    double median = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+};
+
+// Single-pass statistics over a signal fed in blocks of any size, so a capture never has to be in memory at
+// once. Percentiles come from a log-linear histogram of power (16 sub-buckets per octave), which puts them
+// within about 2% of the exact magnitude.
+class StreamingStats {
+public:
+    StreamingStats() { reset(); }
+
+    void push(std::span<const std::complex<double>> block);
+    // Appends the samples `other` has seen, as if they had been pushed after this one's.
+    void merge(const StreamingStats& other);
+    void reset();
+
+    size_t count() const { return samples; }
+    double percentile(double fraction) const;
+    SignalStats stats() const;
+
+private:
+    static constexpr size_t OCTAVES = 128;
+    static constexpr size_t SUB_BUCKETS = 16;
+
+    size_t samples = 0;
+    double power_sum = 0.0;
+    std::complex<double> sum;
+    double peak_power = -1.0;
+    size_t peak_index = 0;
+    std::array<uint64_t, OCTAVES * SUB_BUCKETS> histogram;
+};
+
+// Min/max magnitude envelope of a signal at successively halved resolutions, so any view of it decimates to a
+// display width in time proportional to the width. Holds a view of the signal, which must outlive it.
+class WaveformPyramid {
+public:
+    // Samples per block of the finest level; narrower views read the samples directly.
+    static constexpr size_t BASE_BLOCK = 64;
+
+    explicit WaveformPyramid(std::span<const std::complex<double>> signal);
+
+    size_t size() const { return signal.size(); }
+    size_t levels() const { return low.size(); }
+    // Per column of [begin, end): the smallest and largest magnitude. Columns are widened to the blocks of the
+    // coarsest level that still has one block per column, so neighbouring columns may share up to one block.
+    void envelope(size_t begin, size_t end, size_t width, std::vector<double>& column_low,
+                  std::vector<double>& column_high) const;
+
+private:
+    std::span<const std::complex<double>> signal;
+    // Per level, the min and max power of each block of BASE_BLOCK << level samples.
+    std::vector<std::vector<float>> low;
+    std::vector<std::vector<float>> high;
+};
+
+// Block-max pyramid of a range-Doppler map along range: level k keeps the largest magnitude of every 2^k range
+// bins at full Doppler resolution. Holds a reference to the map, which must outlive it.
+class RangeDopplerPyramid {
+public:
+    explicit RangeDopplerPyramid(const RangeDopplerMap& map);
+
+    const RangeDopplerMap& map() const { return source; }
+    size_t levels() const { return coarse.size() + 1; }
+    // Block-max of range bins [range_begin, range_end) onto rows x columns cells, row-major, from the coarsest
+    // level with at least `rows` bins in view; rows and columns are capped at the bins available.
+    void render(size_t range_begin, size_t range_end, size_t rows, size_t columns, std::vector<double>& cells) const;
+
+private:
+    const RangeDopplerMap& source;
+    std::vector<std::vector<float>> coarse;
+};
+
 class SignalAnalyzer {
 public:
-    static void displayStats(const std::vector<std::complex<double>>& signal);
-    static void plotWaveform(const std::vector<std::complex<double>>& signal, size_t width = 80, size_t height = 20);
-    static void displayRangeDopplerMap(const std::vector<std::vector<double>>& map);
+    static SignalStats computeStats(std::span<const std::complex<double>> signal);
+    static void displayStats(std::span<const std::complex<double>> signal);
+    // One pass over the signal: min and max magnitude of each of min(width, size) columns.
+    static void envelope(std::span<const std::complex<double>> signal, size_t width, std::vector<double>& low,
+                         std::vector<double>& high);
+    static void plotWaveform(std::span<const std::complex<double>> signal, size_t width = 80, size_t height = 20);
+    static void plotWaveform(const WaveformPyramid& pyramid, size_t begin, size_t end, size_t width = 80,
+                             size_t height = 20);
+    // Block-max of the whole map onto rows x columns cells in one pass.
+    static void blockMax(const RangeDopplerMap& map, size_t rows, size_t columns, std::vector<double>& cells);
+    // Cells are shown in dB below the view's peak on a ten-step character ramp spanning dynamic_range_db.
+    static void displayRangeDopplerMap(const RangeDopplerMap& map, size_t rows = 40, size_t columns = 64,
+                                       double dynamic_range_db = 40.0);
+    static void displayRangeDopplerMap(const RangeDopplerPyramid& pyramid, size_t range_begin, size_t range_end,
+                                       size_t rows = 40, size_t columns = 64, double dynamic_range_db = 40.0);
 };
 
 }
\ No newline at end of file
@@ -1,70 +1,83 @@
 #include "signal_generator.h"
-#include <random>
+#include "thread_pool.h"
+#include "metrics.h"
+#include "waveform_library.h"
 #include <cmath>
 #include <algorithm>
+#include <numeric>
 
 namespace RadarToolkit {
 
-constexpr double PI = 3.14159265358979323846;
+template <typename T>
+std::vector<std::complex<T>> BasicSignalGenerator<T>::generateChirp(double f0, double bandwidth, double duration, double fs) {
+    RADAR_METRIC_SCOPE(MetricStage::GenerateChirp);
+    WaveformParams params{WaveformType::LFM, f0, bandwidth, duration, fs};
+    std::vector<std::complex<T>> chirp(BasicWaveformLibrary<T>::length(params));
+    BasicWaveformLibrary<T>::generate(params, chirp);
+    return chirp;
+}
 
-std::vector<std::complex<double>> SignalGenerator::generateChirp(double f0, double bandwidth, double duration, double fs) {
-    size_t num_samples = static_cast<size_t>(duration * fs);
-    std::vector<std::complex<double>> chirp(num_samples);
-    double t_step = 1.0 / fs;
-    double k = bandwidth / duration;
+template <typename T>
+std::vector<std::complex<T>> BasicSignalGenerator<T>::generateBarkerCode(int code_length, double fs, double chip_rate) {
+    RADAR_METRIC_SCOPE(MetricStage::GenerateBarkerCode);
+    WaveformParams params;
+    params.type = WaveformType::Barker;
+    params.fs = fs;
+    params.code_length = code_length;
+    params.chip_rate = chip_rate;
+    std::vector<std::complex<T>> signal(BasicWaveformLibrary<T>::length(params));
+    BasicWaveformLibrary<T>::generate(params, signal);
+    return signal;
+}
 
-    for (size_t i = 0; i < num_samples; ++i) {
-        double t = i * t_step;
-        double phase = 2 * PI * (f0 * t + 0.5 * k * t * t);
-        chirp[i] = std::complex<double>(std::cos(phase), std::sin(phase));
-    }
-    return chirp;
+template <typename T>
+void BasicSignalGenerator<T>::generatePulseTrain(std::span<const std::complex<T>> waveform, size_t num_pulses, BasicPulseMatrix<T>& pulses) {
+    RADAR_METRIC_SCOPE(MetricStage::GeneratePulseTrain);
+    pulses.resize(num_pulses, waveform.size());
+    for (size_t p = 0; p < num_pulses; ++p) std::copy(waveform.begin(), waveform.end(), pulses.row(p).begin());
+}
+
+// Each chunk addresses the stream by its sample offset, so the result does not depend on the thread count.
+template <typename T>
+static void addComplexGaussian(std::span<std::complex<T>> signal, double stddev, const RandomStream& rng) {
+    ThreadPool::shared().parallelFor(signal.size(), [&](size_t begin, size_t end) {
+        rng.addComplexGaussian(signal.subspan(begin, end - begin), static_cast<T>(stddev), begin);
+    }, 16384);
 }
 
-std::vector<std::complex<double>> SignalGenerator::generateBarkerCode(int code_length, double fs) {
-    std::vector<int> barker;
-    if (code_length == 7) barker = {1, 1, 1, -1, -1, 1, -1};
-    else if (code_length == 13) barker = {1, 1, 1, 1, 1, -1, -1, 1, 1, -1, 1, -1, 1};
-    else return {};
+template <typename T>
+static double meanPower(std::span<const std::complex<T>> signal) {
+    return std::accumulate(signal.begin(), signal.end(), 0.0,
+                           [](double sum, const auto& s) { return sum + static_cast<double>(std::norm(s)); }) / signal.size();
+}
 
-    std::vector<std::complex<double>> signal;
-    double chip_duration = 1.0 / fs;
-    for (int phase : barker) {
-        for (size_t i = 0; i < static_cast<size_t>(chip_duration * fs); ++i) {
-            signal.emplace_back(phase, 0.0);
-        }
-    }
-    return signal;
+template <typename T>
+void BasicSignalGenerator<T>::addNoise(std::span<std::complex<T>> signal, double snr_db) {
+    addNoise(signal, snr_db, RandomStream::next());
 }
 
-void SignalGenerator::addNoise(std::vector<std::complex<double>>& signal, double snr_db) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+template <typename T>
+void BasicSignalGenerator<T>::addNoise(std::span<std::complex<T>> signal, double snr_db, const RandomStream& rng) {
+    RADAR_METRIC_SCOPE(MetricStage::AddNoise);
     double snr = std::pow(10.0, snr_db / 10.0);
-    double signal_power = std::accumulate(signal.begin(), signal.end(), 0.0,
-        [](double sum, const auto& s) { return sum + std::norm(s); }) / signal.size();
-    double noise_power = signal_power / snr;
-    double noise_std = std::sqrt(noise_power / 2.0);
+    double noise_power = meanPower<T>(signal) / snr;
+    addComplexGaussian(signal, std::sqrt(noise_power / 2.0), rng);
+}
 
-    std::normal_distribution<double> dist(0.0, noise_std);
-    for (auto& sample : signal) {
-        sample += std::complex<double>(dist(gen), dist(gen));
-    }
+template <typename T>
+void BasicSignalGenerator<T>::addClutter(std::span<std::complex<T>> signal, double cnr_db) {
+    addClutter(signal, cnr_db, RandomStream::next());
 }
 
-void SignalGenerator::addClutter(std::vector<std::complex<double>>& signal, double cnr_db) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+template <typename T>
+void BasicSignalGenerator<T>::addClutter(std::span<std::complex<T>> signal, double cnr_db, const RandomStream& rng) {
+    RADAR_METRIC_SCOPE(MetricStage::AddClutter);
     double cnr = std::pow(10.0, cnr_db / 10.0);
-    double signal_power = std::accumulate(signal.begin(), signal.end(), 0.0,
-        [](double sum, const auto& s) { return sum + std::norm(s); }) / signal.size();
-    double clutter_power = signal_power * cnr;
-    double clutter_std = std::sqrt(clutter_power / 2.0);
-
-    std::normal_distribution<double> dist(0.0, clutter_std);
-    for (auto& sample : signal) {
-        sample += std::complex<double>(dist(gen), dist(gen));
-    }
+    double clutter_power = meanPower<T>(signal) * cnr;
+    addComplexGaussian(signal, std::sqrt(clutter_power / 2.0), rng);
 }
 
+template class BasicSignalGenerator<float>;
+template class BasicSignalGenerator<double>;
+
 }
\ No newline at end of file
@@ -1,15 +1,27 @@
 #pragma once
 #include <vector>
 #include <complex>
+#include <span>
+#include "pulse_matrix.h"
+#include "random.h"
 
 namespace RadarToolkit {
 
-class SignalGenerator {
+template <typename T>
+class BasicSignalGenerator {
 public:
-    static std::vector<std::complex<double>> generateChirp(double f0, double bandwidth, double duration, double fs);
-    static std::vector<std::complex<double>> generateBarkerCode(int code_length, double fs);
-    static void addNoise(std::vector<std::complex<double>>& signal, double snr_db);
-    static void addClutter(std::vector<std::complex<double>>& signal, double cnr_db);
+    static std::vector<std::complex<T>> generateChirp(double f0, double bandwidth, double duration, double fs);
+    // chip_rate sets the oversampling (fs / chip_rate samples per chip); 0 gives one sample per chip.
+    static std::vector<std::complex<T>> generateBarkerCode(int code_length, double fs, double chip_rate = 0.0);
+    static void generatePulseTrain(std::span<const std::complex<T>> waveform, size_t num_pulses, BasicPulseMatrix<T>& pulses);
+    static void addNoise(std::span<std::complex<T>> signal, double snr_db);
+    static void addClutter(std::span<std::complex<T>> signal, double cnr_db);
+    // The unseeded overloads draw successive streams of the master seed (RandomStream::setMasterSeed).
+    static void addNoise(std::span<std::complex<T>> signal, double snr_db, const RandomStream& rng);
+    static void addClutter(std::span<std::complex<T>> signal, double cnr_db, const RandomStream& rng);
 };
 
+using SignalGenerator = BasicSignalGenerator<double>;
+using SignalGeneratorF = BasicSignalGenerator<float>;
+
 }
\ No newline at end of file
@@ -1,100 +1,667 @@
 #include "signal_processor.h"
 #include <cmath>
 #include <algorithm>
+#include <functional>
+#include <mutex>
+#include "thread_pool.h"
+#include "metrics.h"
+#include "simd_kernels.h"
+#include "waveform_library.h"
 
 namespace RadarToolkit {
 
-constexpr double PI = 3.14159265358979323846;
 constexpr double C = 3.0e8;
+constexpr double PI = 3.14159265358979323846;
 
-void SignalProcessor::fft(std::vector<std::complex<double>>& data, bool inverse) {
-    size_t n = data.size();
-    if (n <= 1) return;
+template <typename T>
+void BasicSignalProcessor<T>::fft(std::vector<std::complex<T>>& data, bool inverse) {
+    RADAR_METRIC_SCOPE(MetricStage::FFT);
+    if (data.empty()) return;
+    auto plan = BasicFFTPlan<T>::get(data.size());
+    if (inverse) plan->inverse(data);
+    else plan->forward(data);
+}
 
-    std::vector<std::complex<double>> even(n / 2), odd(n / 2);
-    for (size_t i = 0; i < n / 2; ++i) {
-        even[i] = data[i * 2];
-        odd[i] = data[i * 2 + 1];
-    }
+// Reference lengths at or below this are cheaper to correlate directly than through an FFT.
+constexpr size_t DIRECT_FILTER_MAX_TAPS = 32;
+// Range bins per corner-turn tile in rangeDopplerMap.
+constexpr size_t RANGE_BLOCK = 32;
 
-    fft(even, inverse);
-    fft(odd, inverse);
+// Workspace bytes for `count` values, as allocate() rounds them.
+template <typename U>
+static size_t scratchBytes(size_t count) {
+    return (count * sizeof(U) + Workspace::ALIGNMENT - 1) / Workspace::ALIGNMENT * Workspace::ALIGNMENT;
+}
 
-    double angle = 2 * PI / n * (inverse ? -1 : 1);
-    std::complex<double> w(1), wn(std::cos(angle), std::sin(angle));
-    for (size_t i = 0; i < n / 2; ++i) {
-        std::complex<double> t = w * odd[i];
-        data[i] = even[i] + t;
-        data[i + n / 2] = even[i] - t;
-        w *= wn;
-    }
+// parallelFor runs at most this many tasks, each of which may take one scratch buffer.
+static size_t maxTasks() {
+    return 4 * ThreadPool::shared().size();
+}
+
+template <typename T>
+static size_t cfarScratchBytes(size_t cells, size_t training_cells) {
+    return std::max(scratchBytes<double>(cells + 1), scratchBytes<T>(2 * training_cells));
 }
 
-std::vector<std::complex<double>> SignalProcessor::matchedFilter(const std::vector<std::complex<double>>& signal,
-                                                                const std::vector<std::complex<double>>& reference) {
-    std::vector<std::complex<double>> output(signal.size());
+template <typename T>
+std::vector<std::complex<T>> BasicSignalProcessor<T>::matchedFilterDirect(std::span<const std::complex<T>> signal,
+                                                                          std::span<const std::complex<T>> reference) {
+    RADAR_METRIC_SCOPE(MetricStage::MatchedFilter);
+    std::vector<std::complex<T>> output(signal.size());
     size_t ref_size = reference.size();
 
     for (size_t i = 0; i < signal.size(); ++i) {
-        output[i] = 0.0;
-        for (size_t j = 0; j < ref_size && i >= j; ++j) {
-            output[i] += signal[i - j] * std::conj(reference[j]);
-        }
+        size_t taps = std::min(ref_size, signal.size() - i);
+        output[i] = BasicSIMDKernels<T>::conjugateDot(signal.subspan(i, taps), reference.first(taps));
     }
     return output;
 }
 
-std::vector<size_t> SignalProcessor::cfarDetection(const std::vector<std::complex<double>>& signal, size_t guard_cells,
-                                                  size_t training_cells, double pfa) {
-    std::vector<size_t> detections;
-    double threshold_factor = std::pow(pfa, -1.0 / (training_cells)) - 1;
+template <typename T>
+BasicReferenceSpectrum<T> BasicSignalProcessor<T>::prepareReference(std::span<const std::complex<T>> reference, size_t fft_size,
+                                                                    const WindowSpec& window) {
+    RADAR_METRIC_SCOPE(MetricStage::PrepareReference);
+    BasicReferenceSpectrum<T> result;
+    result.reference_size = reference.size();
+    if (reference.empty()) return result;
+
+    if (fft_size == 0) fft_size = 4 * reference.size();
+    result.fft_size = BasicFFTPlan<T>::nextPowerOfTwo(std::max<size_t>({fft_size, reference.size(), 2}));
+    result.plan = BasicFFTPlan<T>::get(result.fft_size);
+
+    result.spectrum.assign(result.fft_size, 0.0);
+    std::copy(reference.begin(), reference.end(), result.spectrum.begin());
+    if (window.type != WindowType::Rectangular) {
+        auto taper = BasicWindowFunction<T>::get(window, reference.size());
+        for (size_t i = 0; i < reference.size(); ++i) result.spectrum[i] *= (*taper)[i];
+        result.window_loss = BasicWindowFunction<T>::loss(*taper);
+    }
+    result.plan->forward(result.spectrum);
+    for (auto& bin : result.spectrum) bin = std::conj(bin);
+    return result;
+}
 
-    for (size_t i = guard_cells + training_cells; i < signal.size() - guard_cells - training_cells; ++i) {
-        double noise_power = 0.0;
-        size_t count = 0;
+// Overlap-save: each block of fft_size input samples yields fft_size - ref_size + 1 valid lags.
+// A block is copied out before its outputs are written, so output may alias signal.
+template <typename T>
+static void overlapSave(std::span<const std::complex<T>> signal, const BasicReferenceSpectrum<T>& reference,
+                        std::span<std::complex<T>> output, std::span<std::complex<T>> block) {
+    if (reference.fft_size == 0) {
+        std::fill(output.begin(), output.end(), T(0));
+        return;
+    }
+
+    size_t n = reference.fft_size;
+    size_t step = n - reference.reference_size + 1;
+    T scale = T(1) / static_cast<T>(n);
+
+    for (size_t start = 0; start < output.size(); start += step) {
+        size_t available = std::min(n, signal.size() - start);
+        std::copy(signal.begin() + start, signal.begin() + start + available, block.begin());
+        std::fill(block.begin() + available, block.end(), T(0));
+
+        reference.plan->forward(block);
+        BasicSIMDKernels<T>::multiply(block, reference.spectrum, block);
+        reference.plan->inverse(block);
+
+        size_t valid = std::min(step, output.size() - start);
+        for (size_t i = 0; i < valid; ++i) output[start + i] = block[i] * scale;
+    }
+}
+
+template <typename T>
+void BasicSignalProcessor<T>::matchedFilter(std::span<const std::complex<T>> signal, const BasicReferenceSpectrum<T>& reference,
+                                            std::span<std::complex<T>> output) {
+    RADAR_METRIC_SCOPE(MetricStage::MatchedFilter);
+    Workspace workspace(scratchBytes<std::complex<T>>(reference.fft_size));
+    matchedFilter(signal, reference, output, workspace);
+}
+
+template <typename T>
+void BasicSignalProcessor<T>::matchedFilter(std::span<const std::complex<T>> signal, const BasicReferenceSpectrum<T>& reference,
+                                            std::span<std::complex<T>> output, Workspace& workspace) {
+    RADAR_METRIC_SCOPE(MetricStage::MatchedFilter);
+    Workspace::Frame frame(workspace);
+    overlapSave(signal, reference, output, workspace.allocate<std::complex<T>>(reference.fft_size));
+}
+
+template <typename T>
+std::vector<std::complex<T>> BasicSignalProcessor<T>::matchedFilter(std::span<const std::complex<T>> signal,
+                                                                    const BasicReferenceSpectrum<T>& reference) {
+    std::vector<std::complex<T>> output(signal.size());
+    matchedFilter(signal, reference, output);
+    return output;
+}
 
-        for (size_t j = i - guard_cells - training_cells; j < i - guard_cells; ++j) {
-            noise_power += std::norm(signal[j]);
-            count++;
+template <typename T>
+void BasicSignalProcessor<T>::matchedFilter(BasicPulseMatrix<T>& pulses, const BasicReferenceSpectrum<T>& reference) {
+    RADAR_METRIC_SCOPE(MetricStage::PulseCompression);
+    Workspace workspace(maxTasks() * scratchBytes<std::complex<T>>(reference.fft_size));
+    matchedFilter(pulses, reference, workspace);
+}
+
+template <typename T>
+void BasicSignalProcessor<T>::matchedFilter(BasicPulseMatrix<T>& pulses, const BasicReferenceSpectrum<T>& reference,
+                                            Workspace& workspace) {
+    matchedFilter(pulses.view(), reference, workspace);
+}
+
+template <typename T>
+void BasicSignalProcessor<T>::matchedFilter(PulseView<std::complex<T>> pulses, const BasicReferenceSpectrum<T>& reference,
+                                            Workspace& workspace) {
+    RADAR_METRIC_SCOPE(MetricStage::PulseCompression);
+    Workspace::Frame frame(workspace);
+    ThreadPool::shared().parallelFor(pulses.numPulses(), [&](size_t begin, size_t end) {
+        auto block = workspace.allocate<std::complex<T>>(reference.fft_size);
+        for (size_t p = begin; p < end; ++p) overlapSave<T>(pulses.row(p), reference, pulses.row(p), block);
+    });
+}
+
+template <typename T>
+size_t BasicSignalProcessor<T>::workspaceBytes(const BasicReferenceSpectrum<T>& reference, size_t num_pulses,
+                                               size_t samples_per_pulse) {
+    // Each stage closes its frame before the next starts, so the chain needs the largest stage, not the sum.
+    size_t compression = maxTasks() * scratchBytes<std::complex<T>>(reference.fft_size);
+    size_t corner_turn = maxTasks() * scratchBytes<std::complex<T>>(RANGE_BLOCK * num_pulses);
+    // fusedRangeDopplerMap: one overlap-save block and its transposed lags per task, one task per block.
+    size_t step = reference.fft_size - std::min(reference.reference_size, reference.fft_size) + 1;
+    size_t fused_tasks = samples_per_pulse ? std::min(maxTasks(), (samples_per_pulse + step - 1) / step) : maxTasks();
+    size_t fused = fused_tasks * (scratchBytes<std::complex<T>>(reference.fft_size) +
+                                  scratchBytes<std::complex<T>>(step * num_pulses));
+    size_t cfar = scratchBytes<T>(samples_per_pulse) + scratchBytes<double>(samples_per_pulse + 1);
+    size_t cfar_2d = scratchBytes<double>((samples_per_pulse + 1) * (num_pulses + 1));
+    return std::max({compression, corner_turn, fused, cfar, cfar_2d});
+}
+
+template <typename T>
+std::vector<std::complex<T>> BasicSignalProcessor<T>::matchedFilter(std::span<const std::complex<T>> signal,
+                                                                    std::span<const std::complex<T>> reference) {
+    RADAR_METRIC_SCOPE(MetricStage::MatchedFilter);
+    if (reference.size() <= DIRECT_FILTER_MAX_TAPS) return matchedFilterDirect(signal, reference);
+    return matchedFilter(signal, prepareReference(reference));
+}
+
+template <typename PfaOf>
+static double solveThresholdMultiplier(const PfaOf& pfa_of, double pfa) {
+    double lo = 0.0, hi = 1.0;
+    while (pfa_of(hi) > pfa && hi < 1e300) hi *= 2.0;
+    for (int iter = 0; iter < 200 && hi - lo > 1e-12 * hi; ++iter) {
+        double mid = 0.5 * (lo + hi);
+        if (pfa_of(mid) > pfa) lo = mid;
+        else hi = mid;
+    }
+    return hi;
+}
+
+static size_t orderStatisticRank(size_t window_cells, size_t os_rank) {
+    if (os_rank == 0) os_rank = (3 * window_cells + 3) / 4;
+    return std::clamp<size_t>(os_rank, 1, window_cells);
+}
+
+template <typename T>
+double BasicSignalProcessor<T>::cfarThresholdFactor(CFARType type, size_t training_cells, double pfa, size_t os_rank) {
+    double n = static_cast<double>(training_cells);
+    double total = 2.0 * n;
+    switch (type) {
+        case CFARType::CellAveraging:
+            return total * (std::pow(pfa, -1.0 / total) - 1.0);
+        case CFARType::GreatestOf:
+        case CFARType::SmallestOf: {
+            // Gandhi & Kassam: threshold t * Z where Z is the larger/smaller of the two half-window sums.
+            bool greatest = type == CFARType::GreatestOf;
+            auto pfa_of = [training_cells, greatest](double t) {
+                double tail = 0.0, binom = 1.0;
+                for (size_t k = 0; k < training_cells; ++k) {
+                    if (k > 0) binom *= static_cast<double>(training_cells - 1 + k) / static_cast<double>(k);
+                    tail += binom * std::pow(2.0 + t, -static_cast<double>(training_cells + k));
+                }
+                double smallest = 2.0 * tail;
+                return greatest ? 2.0 * std::pow(1.0 + t, -static_cast<double>(training_cells)) - smallest : smallest;
+            };
+            return solveThresholdMultiplier(pfa_of, pfa) * n;
+        }
+        case CFARType::OrderStatistic: {
+            size_t cells = 2 * training_cells;
+            size_t rank = orderStatisticRank(cells, os_rank);
+            auto pfa_of = [cells, rank](double t) {
+                double p = 1.0;
+                for (size_t i = 0; i < rank; ++i) p *= static_cast<double>(cells - i) / (static_cast<double>(cells - i) + t);
+                return p;
+            };
+            return solveThresholdMultiplier(pfa_of, pfa);
         }
-        for (size_t j = i + guard_cells + 1; j <= i + guard_cells + training_cells; ++j) {
-            noise_power += std::norm(signal[j]);
-            count++;
+    }
+    return 0.0;
+}
+
+template <typename T>
+std::vector<size_t> BasicSignalProcessor<T>::cfarDetection(std::span<const std::complex<T>> signal, size_t guard_cells,
+                                                           size_t training_cells, double pfa, CFARType type, size_t os_rank) {
+    RADAR_METRIC_SCOPE(MetricStage::CFAR);
+    std::vector<size_t> detections;
+    Workspace workspace(scratchBytes<T>(signal.size()) + cfarScratchBytes<T>(signal.size(), training_cells));
+    cfarDetection(signal, guard_cells, training_cells, pfa, type, os_rank, detections, workspace);
+    return detections;
+}
+
+template <typename T>
+std::vector<size_t> BasicSignalProcessor<T>::cfarDetection(std::span<const T> power, size_t guard_cells, size_t training_cells,
+                                                           double pfa, CFARType type, size_t os_rank) {
+    RADAR_METRIC_SCOPE(MetricStage::CFAR);
+    std::vector<size_t> detections;
+    Workspace workspace(cfarScratchBytes<T>(power.size(), training_cells));
+    cfarDetection(power, guard_cells, training_cells, pfa, type, os_rank, detections, workspace);
+    return detections;
+}
+
+template <typename T>
+void BasicSignalProcessor<T>::cfarDetection(std::span<const std::complex<T>> signal, size_t guard_cells, size_t training_cells,
+                                            double pfa, CFARType type, size_t os_rank, std::vector<size_t>& detections,
+                                            Workspace& workspace) {
+    RADAR_METRIC_SCOPE(MetricStage::CFAR);
+    Workspace::Frame frame(workspace);
+    auto power = workspace.allocate<T>(signal.size());
+    BasicSIMDKernels<T>::power(signal, power);
+    cfarDetection(power, guard_cells, training_cells, pfa, type, os_rank, detections, workspace);
+}
+
+template <typename T>
+void BasicSignalProcessor<T>::cfarDetection(std::span<const T> power, size_t guard_cells, size_t training_cells, double pfa,
+                                            CFARType type, size_t os_rank, std::vector<size_t>& detections,
+                                            Workspace& workspace) {
+    RADAR_METRIC_SCOPE(MetricStage::CFAR);
+    detections.clear();
+    size_t reach = guard_cells + training_cells;
+    if (training_cells == 0 || power.size() < 2 * reach + 1) return;
+
+    Workspace::Frame frame(workspace);
+    double threshold_factor = cfarThresholdFactor(type, training_cells, pfa, os_rank);
+    size_t first = reach;
+    size_t last = power.size() - reach;
+
+    if (type == CFARType::OrderStatistic) {
+        // The training window slides by one cell per step, so the sorted window is maintained
+        // by two removals and two insertions instead of being rebuilt.
+        size_t rank = orderStatisticRank(2 * training_cells, os_rank);
+        auto window = workspace.allocate<T>(2 * training_cells);
+        std::copy(power.begin(), power.begin() + training_cells, window.begin());
+        std::copy(power.begin() + first + guard_cells + 1, power.begin() + first + reach + 1, window.begin() + training_cells);
+        std::sort(window.begin(), window.end());
+
+        auto replace = [&window](T out, T in) {
+            auto removed = std::lower_bound(window.begin(), window.end(), out);
+            std::copy(removed + 1, window.end(), removed);
+            auto slot = std::upper_bound(window.begin(), window.end() - 1, in);
+            std::copy_backward(slot, window.end() - 1, window.end());
+            *slot = in;
+        };
+
+        for (size_t i = first; i < last; ++i) {
+            if (i > first) {
+                replace(power[i - reach - 1], power[i - guard_cells - 1]);
+                replace(power[i + guard_cells], power[i + reach]);
+            }
+            if (power[i] > threshold_factor * window[rank - 1]) detections.push_back(i);
         }
+        return;
+    }
 
-        noise_power /= count;
-        double threshold = noise_power * threshold_factor;
-        if (std::norm(signal[i]) > threshold) {
-            detections.push_back(i);
+    auto prefix = workspace.allocate<double>(power.size() + 1);
+    prefix[0] = 0.0;
+    for (size_t i = 0; i < power.size(); ++i) prefix[i + 1] = prefix[i] + power[i];
+
+    double inv_cells = 1.0 / static_cast<double>(training_cells);
+    for (size_t i = first; i < last; ++i) {
+        double leading = prefix[i - guard_cells] - prefix[i - reach];
+        double lagging = prefix[i + reach + 1] - prefix[i + guard_cells + 1];
+        double noise_power;
+        switch (type) {
+            case CFARType::GreatestOf: noise_power = std::max(leading, lagging) * inv_cells; break;
+            case CFARType::SmallestOf: noise_power = std::min(leading, lagging) * inv_cells; break;
+            default: noise_power = 0.5 * (leading + lagging) * inv_cells; break;
         }
+        if (power[i] > noise_power * threshold_factor) detections.push_back(i);
     }
+}
+
+template <typename T>
+std::vector<Detection2D> BasicSignalProcessor<T>::cfarDetection2D(const BasicRangeDopplerMap<T>& map, size_t guard_range, size_t guard_doppler,
+                                                                  size_t training_range, size_t training_doppler, double pfa) {
+    RADAR_METRIC_SCOPE(MetricStage::CFAR2D);
+    std::vector<Detection2D> detections;
+    Workspace workspace(scratchBytes<double>((map.num_range_bins + 1) * (map.num_doppler_bins + 1)));
+    cfarDetection2D(map, guard_range, guard_doppler, training_range, training_doppler, pfa, detections, workspace);
     return detections;
 }
 
-std::vector<std::complex<double>> SignalProcessor::computeDoppler(const std::vector<std::complex<double>>& signal,
-                                                                 double f0, double fs, double velocity) {
-    std::vector<std::complex<double>> spectrum = signal;
-    fft(spectrum);
+template <typename T>
+void BasicSignalProcessor<T>::cfarDetection2D(const BasicRangeDopplerMap<T>& map, size_t guard_range, size_t guard_doppler,
+                                              size_t training_range, size_t training_doppler, double pfa,
+                                              std::vector<Detection2D>& detections, Workspace& workspace) {
+    cfarDetection2D(map.data, map.num_range_bins, map.num_doppler_bins, guard_range, guard_doppler, training_range,
+                    training_doppler, pfa, detections, workspace);
+}
+
+template <typename T>
+void BasicSignalProcessor<T>::cfarDetection2D(std::span<const T> magnitudes, size_t num_range_bins, size_t num_doppler_bins,
+                                              size_t guard_range, size_t guard_doppler, size_t training_range,
+                                              size_t training_doppler, double pfa, std::vector<Detection2D>& detections,
+                                              Workspace& workspace) {
+    RADAR_METRIC_SCOPE(MetricStage::CFAR2D);
+    detections.clear();
+    size_t rows = num_range_bins;
+    size_t cols = num_doppler_bins;
+    size_t reach_r = guard_range + training_range;
+    size_t reach_d = guard_doppler + training_doppler;
+    if (rows < 2 * reach_r + 1 || cols < 2 * reach_d + 1) return;
+
+    size_t outer_cells = (2 * reach_r + 1) * (2 * reach_d + 1);
+    size_t guard_cells = (2 * guard_range + 1) * (2 * guard_doppler + 1);
+    if (outer_cells == guard_cells) return;
+    double cells = static_cast<double>(outer_cells - guard_cells);
+    double threshold_factor = cells * (std::pow(pfa, -1.0 / cells) - 1.0);
+
+    // Summed-area table of detected power: row prefix sums in parallel, then column accumulation in parallel.
+    Workspace::Frame frame(workspace);
+    size_t stride = cols + 1;
+    auto table = workspace.allocate<double>(stride * (rows + 1));
+    std::fill(table.begin(), table.begin() + stride, 0.0);
+    auto& pool = ThreadPool::shared();
+    pool.parallelFor(rows, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            double* out = table.data() + (r + 1) * stride;
+            const T* in = magnitudes.data() + r * cols;
+            out[0] = 0.0;
+            for (size_t d = 0; d < cols; ++d) out[d + 1] = out[d] + static_cast<double>(in[d]) * in[d];
+        }
+    }, 64);
+    pool.parallelFor(stride, [&](size_t begin, size_t end) {
+        for (size_t r = 1; r <= rows; ++r) {
+            double* out = table.data() + r * stride;
+            const double* above = out - stride;
+            for (size_t d = begin; d < end; ++d) out[d] += above[d];
+        }
+    }, 256);
+
+    auto box = [&](size_t r0, size_t d0, size_t r1, size_t d1) {
+        return table[r1 * stride + d1] - table[r0 * stride + d1] - table[r1 * stride + d0] + table[r0 * stride + d0];
+    };
+
+    // Tasks append under a lock; sorting afterwards restores range-major order independent of scheduling.
+    std::mutex found_mutex;
+    pool.parallelFor(rows - 2 * reach_r, [&](size_t begin, size_t end) {
+        for (size_t r = begin + reach_r; r < end + reach_r; ++r) {
+            for (size_t d = reach_d; d < cols - reach_d; ++d) {
+                double outer = box(r - reach_r, d - reach_d, r + reach_r + 1, d + reach_d + 1);
+                double inner = box(r - guard_range, d - guard_doppler, r + guard_range + 1, d + guard_doppler + 1);
+                double noise_power = (outer - inner) / cells;
+                double cut = magnitudes[r * cols + d];
+                if (cut * cut > noise_power * threshold_factor) {
+                    std::lock_guard<std::mutex> lock(found_mutex);
+                    detections.push_back({r, d});
+                }
+            }
+        }
+    }, 16);
+    std::sort(detections.begin(), detections.end(), [](const Detection2D& a, const Detection2D& b) {
+        return a.range_bin != b.range_bin ? a.range_bin < b.range_bin : a.doppler_bin < b.doppler_bin;
+    });
+}
+
+// DFT of the signal at `cycles` per sample through the Goertzel recurrence, accumulated in double.
+template <typename T>
+static std::complex<double> goertzel(std::span<const std::complex<T>> signal, double cycles) {
+    if (signal.empty()) return 0.0;
+    double omega = 2.0 * PI * cycles;
+    double coefficient = 2.0 * std::cos(omega);
+    std::complex<double> s1 = 0.0, s2 = 0.0;
+    for (const auto& x : signal) {
+        std::complex<double> s0 = std::complex<double>(x) + coefficient * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    // s1 - e^{-jw} s2 = sum x[n] e^{jw(N-1-n)}; rotate back to sum x[n] e^{-jwn}.
+    return (s1 - std::polar(1.0, -omega) * s2) * std::polar(1.0, -omega * static_cast<double>(signal.size() - 1));
+}
+
+template <typename T>
+std::vector<std::complex<T>> BasicSignalProcessor<T>::computeDoppler(std::span<const std::complex<T>> signal,
+                                                                     double f0, double fs, double velocity) {
+    RADAR_METRIC_SCOPE(MetricStage::Doppler);
+    size_t n = signal.size();
+    std::vector<std::complex<T>> result(n);
+    if (n == 0) return result;
     double doppler_shift = 2 * velocity * f0 / C;
-    std::vector<std::complex<double>> result(spectrum.size());
-    for (size_t i = 0; i < spectrum.size(); ++i) {
-        double freq = i * fs / spectrum.size();
-        result[i] = (std::abs(freq - doppler_shift) < fs / spectrum.size()) ? spectrum[i] : 0.0;
+    // Only bins within one bin width of the shift are kept, so at most two DFT bins are evaluated.
+    double centre = doppler_shift * n / fs;
+    double first = std::max(0.0, std::floor(centre) - 1.0);
+    for (double bin = first; bin <= centre + 1.0 && bin < n; ++bin) {
+        size_t i = static_cast<size_t>(bin);
+        double freq = i * fs / n;
+        if (std::abs(freq - doppler_shift) < fs / n) {
+            result[i] = std::complex<T>(goertzel(signal, static_cast<double>(i) / n));
+        }
     }
     return result;
 }
 
-std::vector<std::vector<double>> SignalProcessor::rangeDopplerMap(const std::vector<std::vector<std::complex<double>>>& pulses,
-                                                                 double f0, double fs) {
-    std::vector<std::vector<double>> map(pulses.size(), std::vector<double>(pulses[0].size()));
-    for (size_t i = 0; i < pulses.size(); ++i) {
-        std::vector<std::complex<double>> spectrum = pulses[i];
-        fft(spectrum);
-        for (size_t j = 0; j < spectrum.size(); ++j) {
-            map[i][j] = std::abs(spectrum[j]);
+template <typename T>
+BasicDopplerSpectrum<T> BasicSignalProcessor<T>::dopplerFilterBank(std::span<const std::complex<T>> signal, double f0,
+                                                                   double sample_rate, std::span<const double> velocities) {
+    RADAR_METRIC_SCOPE(MetricStage::Doppler);
+    BasicDopplerSpectrum<T> spectrum;
+    spectrum.velocities.assign(velocities.begin(), velocities.end());
+    spectrum.power.resize(velocities.size());
+    ThreadPool::shared().parallelFor(velocities.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            double cycles = 2.0 * velocities[i] * f0 / C / sample_rate;
+            spectrum.power[i] = static_cast<T>(std::norm(goertzel(signal, cycles)));
         }
+    });
+    return spectrum;
+}
+
+template <typename T>
+BasicDopplerSpectrum<T> BasicSignalProcessor<T>::dopplerFilterBank(std::span<const std::complex<T>> signal, double f0,
+                                                                   double sample_rate, double min_velocity,
+                                                                   double max_velocity, size_t count,
+                                                                   DopplerBankMethod method) {
+    RADAR_METRIC_SCOPE(MetricStage::Doppler);
+    std::vector<double> velocities(count);
+    double step = count > 1 ? (max_velocity - min_velocity) / static_cast<double>(count - 1) : 0.0;
+    for (size_t k = 0; k < count; ++k) velocities[k] = min_velocity + step * static_cast<double>(k);
+
+    size_t n = signal.size();
+    size_t fft_size = BasicFFTPlan<T>::nextPowerOfTwo(n + count);
+    if (method == DopplerBankMethod::Auto) {
+        // Measured costs: a Goertzel step per sample and hypothesis against about two of those per L log2 L of
+        // the three transforms, chirps included.
+        double goertzel_cost = static_cast<double>(count) * static_cast<double>(n);
+        double chirp_z_cost = 2.0 * fft_size * std::log2(static_cast<double>(fft_size));
+        method = goertzel_cost <= chirp_z_cost ? DopplerBankMethod::Goertzel : DopplerBankMethod::ChirpZ;
+    }
+    if (method == DopplerBankMethod::Goertzel || n == 0 || count < 2) {
+        return dopplerFilterBank(signal, f0, sample_rate, velocities);
     }
+
+    // Chirp-z over f_k = start + k delta (cycles per sample): with kn = (k^2 + n^2 - (k - n)^2) / 2,
+    // X_k = e^{-j pi delta k^2} sum_n [x_n e^{-j 2 pi start n} e^{-j pi delta n^2}] e^{j pi delta (k - n)^2},
+    // a linear convolution done with one FFT size. The outer chirp has unit modulus, so power needs only |g_k|.
+    double start = 2.0 * min_velocity * f0 / C / sample_rate;
+    double delta = 2.0 * step * f0 / C / sample_rate;
+    std::vector<std::complex<double>> chirp(std::max(n, count)), modulation(n);
+    WaveformLibrary::quadraticPhase(chirp, 0.0, 0.5 * delta);
+    WaveformLibrary::quadraticPhase(modulation, -start, -0.5 * delta);
+    std::vector<std::complex<T>> y(fft_size), h(fft_size);
+    for (size_t i = 0; i < n; ++i) y[i] = std::complex<T>(std::complex<double>(signal[i]) * modulation[i]);
+    for (size_t m = 0; m < count; ++m) h[m] = std::complex<T>(chirp[m]);
+    for (size_t m = 1; m < n; ++m) h[fft_size - m] = std::complex<T>(chirp[m]);
+
+    auto plan = BasicFFTPlan<T>::get(fft_size);
+    plan->forward(y);
+    plan->forward(h);
+    BasicSIMDKernels<T>::multiply(y, h, y);
+    plan->inverse(y);
+
+    BasicDopplerSpectrum<T> spectrum;
+    spectrum.velocities = std::move(velocities);
+    spectrum.power.resize(count);
+    T scale = T(1) / static_cast<T>(fft_size);
+    for (size_t k = 0; k < count; ++k) spectrum.power[k] = std::norm(y[k] * scale);
+    return spectrum;
+}
+
+// Geometry and Doppler window loss of the map of a num_pulses x num_samples CPI; data is sized, not filled.
+template <typename T>
+static void shapeMap(BasicRangeDopplerMap<T>& map, size_t num_pulses, size_t num_samples, double f0, double fs,
+                     double prf, const WindowSpec& doppler_window) {
+    map.num_range_bins = num_samples;
+    map.num_doppler_bins = num_pulses;
+    map.range_resolution = C / (2.0 * fs);
+    map.velocity_resolution = (prf > 0.0 && f0 > 0.0) ? prf / num_pulses * C / (2.0 * f0) : 0.0;
+    map.data.resize(num_samples * num_pulses);
+    map.doppler_window_loss = BasicWindowFunction<T>::loss(*BasicWindowFunction<T>::get(doppler_window, num_pulses));
+}
+
+// Transforms one range bin across slow time and writes the magnitudes straight into their fftshifted positions.
+template <typename T>
+static void dopplerMagnitudes(std::span<std::complex<T>> slow_time, const BasicFFTPlan<T>& plan, std::span<T> out) {
+    plan.forward(slow_time);
+    size_t half = slow_time.size() / 2;
+    BasicSIMDKernels<T>::magnitude(slow_time.first(slow_time.size() - half), out.subspan(half));
+    BasicSIMDKernels<T>::magnitude(slow_time.subspan(slow_time.size() - half), out.first(half));
+}
+
+template <typename T>
+BasicRangeDopplerMap<T> BasicSignalProcessor<T>::rangeDopplerMap(const BasicPulseMatrix<T>& pulses, double f0, double fs, double prf,
+                                                                 const WindowSpec& doppler_window) {
+    RADAR_METRIC_SCOPE(MetricStage::RangeDopplerMap);
+    BasicRangeDopplerMap<T> map;
+    Workspace workspace(maxTasks() * scratchBytes<std::complex<T>>(RANGE_BLOCK * pulses.numPulses()));
+    rangeDopplerMap(pulses, f0, fs, prf, doppler_window, map, workspace);
+    return map;
+}
+
+template <typename T>
+BasicRangeDopplerMap<T> BasicSignalProcessor<T>::rangeDopplerMap(BasicPulseMatrix<T>& pulses, const BasicReferenceSpectrum<T>& reference,
+                                                                 double f0, double fs, double prf, const WindowSpec& doppler_window) {
+    RADAR_METRIC_SCOPE(MetricStage::RangeDopplerMap);
+    BasicRangeDopplerMap<T> map;
+    Workspace workspace(workspaceBytes(reference, pulses.numPulses(), 0));
+    rangeDopplerMap(pulses, reference, f0, fs, prf, doppler_window, map, workspace);
     return map;
 }
 
+template <typename T>
+void BasicSignalProcessor<T>::rangeDopplerMap(const BasicPulseMatrix<T>& pulses, double f0, double fs, double prf,
+                                              const WindowSpec& doppler_window, BasicRangeDopplerMap<T>& map,
+                                              Workspace& workspace) {
+    if (pulses.empty()) {
+        map = BasicRangeDopplerMap<T>{};
+        return;
+    }
+    shapeMap(map, pulses.numPulses(), pulses.numSamples(), f0, fs, prf, doppler_window);
+    rangeDopplerMagnitudes(pulses.view(), doppler_window, map.data, workspace);
+}
+
+template <typename T>
+void BasicSignalProcessor<T>::rangeDopplerMagnitudes(PulseView<const std::complex<T>> pulses, const WindowSpec& doppler_window,
+                                                     std::span<T> magnitudes, Workspace& workspace) {
+    RADAR_METRIC_SCOPE(MetricStage::RangeDopplerMap);
+    if (pulses.empty()) return;
+    size_t num_pulses = pulses.numPulses();
+    size_t num_samples = pulses.numSamples();
+    auto taper = BasicWindowFunction<T>::get(doppler_window, num_pulses);
+    const std::vector<T>& window = *taper;
+
+    // Corner turn: each task transposes a tile of range bins into slow-time-contiguous rows,
+    // applying the Doppler taper on the way, then transforms and detects them while still in cache.
+    constexpr size_t PULSE_BLOCK = 64;
+    auto plan = BasicFFTPlan<T>::get(num_pulses);
+    Workspace::Frame frame(workspace);
+
+    ThreadPool::shared().parallelFor(num_samples, [&](size_t begin, size_t end) {
+        auto turned = workspace.allocate<std::complex<T>>(RANGE_BLOCK * num_pulses);
+        for (size_t r0 = begin; r0 < end; r0 += RANGE_BLOCK) {
+            size_t r1 = std::min(end, r0 + RANGE_BLOCK);
+            for (size_t p0 = 0; p0 < num_pulses; p0 += PULSE_BLOCK) {
+                size_t p1 = std::min(num_pulses, p0 + PULSE_BLOCK);
+                for (size_t p = p0; p < p1; ++p) {
+                    const std::complex<T>* row = pulses.row(p).data();
+                    for (size_t r = r0; r < r1; ++r) turned[(r - r0) * num_pulses + p] = row[r] * window[p];
+                }
+            }
+            for (size_t r = r0; r < r1; ++r) {
+                dopplerMagnitudes<T>(turned.subspan((r - r0) * num_pulses, num_pulses), *plan,
+                                     magnitudes.subspan(r * num_pulses, num_pulses));
+            }
+        }
+    }, RANGE_BLOCK);
+}
+
+template <typename T>
+void BasicSignalProcessor<T>::fusedRangeDopplerMap(const BasicPulseMatrix<T>& pulses,
+                                                   const BasicReferenceSpectrum<T>& reference, double f0, double fs,
+                                                   double prf, const WindowSpec& doppler_window,
+                                                   BasicRangeDopplerMap<T>& map, Workspace& workspace) {
+    RADAR_METRIC_SCOPE(MetricStage::RangeDopplerMap);
+    if (pulses.empty()) {
+        map = BasicRangeDopplerMap<T>{};
+        return;
+    }
+    const size_t num_pulses = pulses.numPulses();
+    const size_t num_samples = pulses.numSamples();
+    shapeMap(map, num_pulses, num_samples, f0, fs, prf, doppler_window);
+    if (reference.fft_size == 0) {
+        std::fill(map.data.begin(), map.data.end(), T(0));
+        return;
+    }
+    auto taper = BasicWindowFunction<T>::get(doppler_window, num_pulses);
+    const std::vector<T>& window = *taper;
+    auto plan = BasicFFTPlan<T>::get(num_pulses);
+    const size_t n = reference.fft_size;
+    const size_t step = n - reference.reference_size + 1;
+    const T scale = T(1) / static_cast<T>(n);
+    Workspace::Frame frame(workspace);
+
+    // Each task owns whole overlap-save blocks: it compresses the block's lags of every pulse and transposes them,
+    // tapered and scaled, into a slow-time-major tile, then runs the Doppler FFTs of those range bins. The
+    // compressed CPI only ever exists one tile at a time.
+    ThreadPool::shared().parallelFor((num_samples + step - 1) / step, [&](size_t begin, size_t end) {
+        auto block = workspace.allocate<std::complex<T>>(n);
+        auto turned = workspace.allocate<std::complex<T>>(step * num_pulses);
+        for (size_t b = begin; b < end; ++b) {
+            const size_t start = b * step;
+            const size_t width = std::min(step, num_samples - start);
+            const size_t available = std::min(n, num_samples - start);
+            for (size_t p = 0; p < num_pulses; ++p) {
+                auto row = pulses.row(p);
+                std::copy_n(row.begin() + start, available, block.begin());
+                std::fill(block.begin() + available, block.end(), T(0));
+                reference.plan->forward(block);
+                BasicSIMDKernels<T>::multiply(block, reference.spectrum, block);
+                reference.plan->inverse(block);
+                const T weight = window[p] * scale;
+                for (size_t i = 0; i < width; ++i) turned[i * num_pulses + p] = block[i] * weight;
+            }
+            for (size_t i = 0; i < width; ++i) {
+                dopplerMagnitudes<T>(turned.subspan(i * num_pulses, num_pulses), *plan,
+                                     std::span<T>(map.data).subspan((start + i) * num_pulses, num_pulses));
+            }
+        }
+    });
+}
+
+template <typename T>
+void BasicSignalProcessor<T>::rangeDopplerMap(BasicPulseMatrix<T>& pulses, const BasicReferenceSpectrum<T>& reference,
+                                              double f0, double fs, double prf, const WindowSpec& doppler_window,
+                                              BasicRangeDopplerMap<T>& map, Workspace& workspace) {
+    RADAR_METRIC_SCOPE(MetricStage::RangeDopplerMap);
+    matchedFilter(pulses, reference, workspace);
+    rangeDopplerMap(pulses, f0, fs, prf, doppler_window, map, workspace);
+}
+
+template class BasicSignalProcessor<float>;
+template class BasicSignalProcessor<double>;
+
 }
\ No newline at end of file
@@ -1,21 +1,153 @@
 #pragma once
 #include <vector>
 #include <complex>
+#include <memory>
+#include <span>
+#include <algorithm>
+#include "fft_plan.h"
+#include "pulse_matrix.h"
+#include "window.h"
+#include "workspace.h"
 
 namespace RadarToolkit {
 
-class SignalProcessor {
+template <typename T>
+struct BasicReferenceSpectrum {
+    size_t reference_size = 0;
+    size_t fft_size = 0;
+    std::vector<std::complex<T>> spectrum;
+    std::shared_ptr<const BasicFFTPlan<T>> plan;
+    // Range taper folded into the spectrum, and the SNR corrections it implies.
+    WindowLoss window_loss;
+};
+
+// Magnitudes stored range-major (one contiguous Doppler spectrum per range bin), with the
+// Doppler axis shifted so that zero velocity sits at bin num_doppler_bins / 2.
+template <typename T>
+struct BasicRangeDopplerMap {
+    size_t num_range_bins = 0;
+    size_t num_doppler_bins = 0;
+    double range_resolution = 0.0;
+    double velocity_resolution = 0.0;
+    WindowLoss doppler_window_loss;
+    std::vector<T> data;
+
+    T at(size_t range_bin, size_t doppler_bin) const { return data[range_bin * num_doppler_bins + doppler_bin]; }
+    double range(size_t range_bin) const { return range_bin * range_resolution; }
+    double velocity(size_t doppler_bin) const {
+        return (static_cast<double>(doppler_bin) - static_cast<double>(num_doppler_bins / 2)) * velocity_resolution;
+    }
+};
+
+enum class CFARType { CellAveraging, GreatestOf, SmallestOf, OrderStatistic };
+
+// Power |X(f)|^2 of the DFT at the Doppler frequency 2 v f0 / c of each velocity hypothesis.
+template <typename T>
+struct BasicDopplerSpectrum {
+    std::vector<double> velocities;
+    std::vector<T> power;
+
+    size_t peak() const { return std::max_element(power.begin(), power.end()) - power.begin(); }
+};
+
+// Goertzel costs O(N) per hypothesis; a chirp-z zoom costs O(L log L) for the whole band (L >= N + count - 1).
+enum class DopplerBankMethod { Auto, Goertzel, ChirpZ };
+
+struct Detection2D {
+    size_t range_bin;
+    size_t doppler_bin;
+};
+
+// Instantiated for float and double samples; see the SignalProcessor/SignalProcessorF aliases.
+template <typename T>
+class BasicSignalProcessor {
 public:
-    static std::vector<std::complex<double>> matchedFilter(const std::vector<std::complex<double>>& signal,
-                                                          const std::vector<std::complex<double>>& reference);
-    static std::vector<size_t> cfarDetection(const std::vector<std::complex<double>>& signal, size_t guard_cells,
-                                            size_t training_cells, double pfa);
-    static std::vector<std::complex<double>> computeDoppler(const std::vector<std::complex<double>>& signal,
-                                                           double f0, double fs, double velocity);
-    static std::vector<std::vector<double>> rangeDopplerMap(const std::vector<std::vector<std::complex<double>>>& pulses,
-                                                           double f0, double fs);
-private:
-    static void fft(std::vector<std::complex<double>>& data, bool inverse = false);
+    static std::vector<std::complex<T>> matchedFilter(std::span<const std::complex<T>> signal,
+                                                      std::span<const std::complex<T>> reference);
+    static std::vector<std::complex<T>> matchedFilter(std::span<const std::complex<T>> signal,
+                                                      const BasicReferenceSpectrum<T>& reference);
+    // Computes the first output.size() lags (at most signal.size()); output may alias signal.
+    static void matchedFilter(std::span<const std::complex<T>> signal, const BasicReferenceSpectrum<T>& reference,
+                              std::span<std::complex<T>> output);
+    static void matchedFilter(BasicPulseMatrix<T>& pulses, const BasicReferenceSpectrum<T>& reference);
+    static std::vector<std::complex<T>> matchedFilterDirect(std::span<const std::complex<T>> signal,
+                                                            std::span<const std::complex<T>> reference);
+    // A range window tapers the reference before its spectrum is taken, so sidelobe control costs nothing per pulse.
+    static BasicReferenceSpectrum<T> prepareReference(std::span<const std::complex<T>> reference, size_t fft_size = 0,
+                                                      const WindowSpec& window = {});
+    static std::vector<size_t> cfarDetection(std::span<const std::complex<T>> signal, size_t guard_cells,
+                                             size_t training_cells, double pfa,
+                                            CFARType type = CFARType::CellAveraging, size_t os_rank = 0);
+    static std::vector<size_t> cfarDetection(std::span<const T> power, size_t guard_cells, size_t training_cells,
+                                             double pfa, CFARType type = CFARType::CellAveraging, size_t os_rank = 0);
+    static std::vector<Detection2D> cfarDetection2D(const BasicRangeDopplerMap<T>& map, size_t guard_range, size_t guard_doppler,
+                                                    size_t training_range, size_t training_doppler, double pfa);
+    // Multiplier applied to the mean training-cell power (CA/GO/SO) or to the os_rank-th
+    // smallest training cell (OS) for square-law detected noise; os_rank 0 means 3/4 of the window.
+    static double cfarThresholdFactor(CFARType type, size_t training_cells, double pfa, size_t os_rank = 0);
+    static std::vector<std::complex<T>> computeDoppler(std::span<const std::complex<T>> signal,
+                                                       double f0, double fs, double velocity);
+    // Evaluates every velocity hypothesis in one pass over a signal sampled at sample_rate (fs in fast time, the
+    // PRF in slow time): a Goertzel filter per listed velocity.
+    static BasicDopplerSpectrum<T> dopplerFilterBank(std::span<const std::complex<T>> signal, double f0,
+                                                     double sample_rate, std::span<const double> velocities);
+    // count velocities evenly spaced over [min_velocity, max_velocity]; Auto picks the cheaper of a Goertzel bank
+    // and a chirp-z zoom FFT of the sub-band.
+    static BasicDopplerSpectrum<T> dopplerFilterBank(std::span<const std::complex<T>> signal, double f0,
+                                                     double sample_rate, double min_velocity, double max_velocity,
+                                                     size_t count, DopplerBankMethod method = DopplerBankMethod::Auto);
+    // The Doppler window is applied during the corner turn.
+    static BasicRangeDopplerMap<T> rangeDopplerMap(const BasicPulseMatrix<T>& pulses, double f0, double fs, double prf = 0.0,
+                                                   const WindowSpec& doppler_window = {WindowType::Hann});
+    // Range-compresses the pulses in place before Doppler processing.
+    static BasicRangeDopplerMap<T> rangeDopplerMap(BasicPulseMatrix<T>& pulses, const BasicReferenceSpectrum<T>& reference,
+                                                   double f0, double fs, double prf = 0.0,
+                                                   const WindowSpec& doppler_window = {WindowType::Hann});
+    static void fft(std::vector<std::complex<T>>& data, bool inverse = false);
+
+    // Workspace overloads take their temporaries from the workspace and write into caller-owned outputs
+    // whose capacity is reused, so once the workspace has seen one CPI, the chain allocates nothing.
+    // workspaceBytes() sizes a workspace for the whole chain on num_pulses x samples_per_pulse CPIs.
+    static size_t workspaceBytes(const BasicReferenceSpectrum<T>& reference, size_t num_pulses, size_t samples_per_pulse);
+    static void matchedFilter(std::span<const std::complex<T>> signal, const BasicReferenceSpectrum<T>& reference,
+                              std::span<std::complex<T>> output, Workspace& workspace);
+    static void matchedFilter(BasicPulseMatrix<T>& pulses, const BasicReferenceSpectrum<T>& reference, Workspace& workspace);
+    static void cfarDetection(std::span<const std::complex<T>> signal, size_t guard_cells, size_t training_cells, double pfa,
+                              CFARType type, size_t os_rank, std::vector<size_t>& detections, Workspace& workspace);
+    static void cfarDetection(std::span<const T> power, size_t guard_cells, size_t training_cells, double pfa,
+                              CFARType type, size_t os_rank, std::vector<size_t>& detections, Workspace& workspace);
+    static void cfarDetection2D(const BasicRangeDopplerMap<T>& map, size_t guard_range, size_t guard_doppler,
+                                size_t training_range, size_t training_doppler, double pfa,
+                                std::vector<Detection2D>& detections, Workspace& workspace);
+    static void rangeDopplerMap(const BasicPulseMatrix<T>& pulses, double f0, double fs, double prf,
+                                const WindowSpec& doppler_window, BasicRangeDopplerMap<T>& map, Workspace& workspace);
+    static void rangeDopplerMap(BasicPulseMatrix<T>& pulses, const BasicReferenceSpectrum<T>& reference, double f0, double fs,
+                                double prf, const WindowSpec& doppler_window, BasicRangeDopplerMap<T>& map,
+                                Workspace& workspace);
+    // Matched filter and map in one pass over the CPI: the pulses are compressed a range tile at a time inside the
+    // corner turn and left unchanged. Use it when nothing after the map needs the compressed pulses.
+    static void fusedRangeDopplerMap(const BasicPulseMatrix<T>& pulses, const BasicReferenceSpectrum<T>& reference,
+                                     double f0, double fs, double prf, const WindowSpec& doppler_window,
+                                     BasicRangeDopplerMap<T>& map, Workspace& workspace);
+
+    // The same stages on memory the caller owns, e.g. arrays handed over through the C interface. The CPI is
+    // compressed in place; magnitudes are num_samples x num_pulses values laid out as BasicRangeDopplerMap::data.
+    static void matchedFilter(PulseView<std::complex<T>> pulses, const BasicReferenceSpectrum<T>& reference,
+                              Workspace& workspace);
+    static void rangeDopplerMagnitudes(PulseView<const std::complex<T>> pulses, const WindowSpec& doppler_window,
+                                       std::span<T> magnitudes, Workspace& workspace);
+    static void cfarDetection2D(std::span<const T> magnitudes, size_t num_range_bins, size_t num_doppler_bins,
+                                size_t guard_range, size_t guard_doppler, size_t training_range, size_t training_doppler,
+                                double pfa, std::vector<Detection2D>& detections, Workspace& workspace);
 };
 
+using ReferenceSpectrum = BasicReferenceSpectrum<double>;
+using ReferenceSpectrumF = BasicReferenceSpectrum<float>;
+using RangeDopplerMap = BasicRangeDopplerMap<double>;
+using RangeDopplerMapF = BasicRangeDopplerMap<float>;
+using DopplerSpectrum = BasicDopplerSpectrum<double>;
+using DopplerSpectrumF = BasicDopplerSpectrum<float>;
+using SignalProcessor = BasicSignalProcessor<double>;
+using SignalProcessorF = BasicSignalProcessor<float>;
+
 }
\ No newline at end of file
@@ -0,0 +1,540 @@
+#include "simd_kernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RADAR_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define RADAR_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace RadarToolkit {
+
+// Each level is a table of plain functions over raw pointers; only the table pointer is switched at runtime.
+template <typename T>
+struct KernelTable {
+    SIMDLevel level;
+    void (*multiply)(const std::complex<T>*, const std::complex<T>*, std::complex<T>*, size_t);
+    std::complex<T> (*conjugateDot)(const std::complex<T>*, const std::complex<T>*, size_t);
+    void (*power)(const std::complex<T>*, T*, size_t);
+    void (*magnitude)(const std::complex<T>*, T*, size_t);
+    void (*scaledAdd)(const std::complex<T>*, T, std::complex<T>*, size_t);
+};
+
+// ---- Scalar reference ----
+
+template <typename T>
+static void multiplyScalar(const std::complex<T>* a, const std::complex<T>* b, std::complex<T>* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        T re = a[i].real() * b[i].real() - a[i].imag() * b[i].imag();
+        T im = a[i].imag() * b[i].real() + a[i].real() * b[i].imag();
+        out[i] = {re, im};
+    }
+}
+
+template <typename T>
+static std::complex<T> conjugateDotScalar(const std::complex<T>* a, const std::complex<T>* b, size_t n) {
+    T re = 0, im = 0;
+    for (size_t i = 0; i < n; ++i) {
+        re += a[i].real() * b[i].real() + a[i].imag() * b[i].imag();
+        im += a[i].imag() * b[i].real() - a[i].real() * b[i].imag();
+    }
+    return {re, im};
+}
+
+template <typename T>
+static void powerScalar(const std::complex<T>* a, T* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = a[i].real() * a[i].real() + a[i].imag() * a[i].imag();
+}
+
+template <typename T>
+static void magnitudeScalar(const std::complex<T>* a, T* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = std::sqrt(a[i].real() * a[i].real() + a[i].imag() * a[i].imag());
+}
+
+template <typename T>
+static void scaledAddScalar(const std::complex<T>* x, T alpha, std::complex<T>* y, size_t n) {
+    for (size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+}
+
+template <typename T>
+static const KernelTable<T> scalar_table = {SIMDLevel::Scalar, multiplyScalar<T>, conjugateDotScalar<T>, powerScalar<T>,
+                                            magnitudeScalar<T>, scaledAddScalar<T>};
+
+#if RADAR_SIMD_X86
+
+// ---- AVX2 + FMA: 2 complex doubles / 4 complex floats per register ----
+
+#define RADAR_AVX2 __attribute__((target("avx2,fma")))
+
+RADAR_AVX2 static void multiplyAVX2(const std::complex<double>* a, const std::complex<double>* b, std::complex<double>* out, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m256d va = _mm256_loadu_pd(reinterpret_cast<const double*>(a + i));
+        __m256d vb = _mm256_loadu_pd(reinterpret_cast<const double*>(b + i));
+        __m256d swapped = _mm256_permute_pd(va, 0x5);
+        __m256d cross = _mm256_mul_pd(swapped, _mm256_permute_pd(vb, 0xF));
+        _mm256_storeu_pd(reinterpret_cast<double*>(out + i), _mm256_fmaddsub_pd(va, _mm256_movedup_pd(vb), cross));
+    }
+    multiplyScalar(a + i, b + i, out + i, n - i);
+}
+
+RADAR_AVX2 static void multiplyAVX2(const std::complex<float>* a, const std::complex<float>* b, std::complex<float>* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256 va = _mm256_loadu_ps(reinterpret_cast<const float*>(a + i));
+        __m256 vb = _mm256_loadu_ps(reinterpret_cast<const float*>(b + i));
+        __m256 swapped = _mm256_permute_ps(va, 0xB1);
+        __m256 cross = _mm256_mul_ps(swapped, _mm256_movehdup_ps(vb));
+        _mm256_storeu_ps(reinterpret_cast<float*>(out + i), _mm256_fmaddsub_ps(va, _mm256_moveldup_ps(vb), cross));
+    }
+    multiplyScalar(a + i, b + i, out + i, n - i);
+}
+
+RADAR_AVX2 static std::complex<double> conjugateDotAVX2(const std::complex<double>* a, const std::complex<double>* b, size_t n) {
+    // Accumulate a * b_re and swap(a) * b_im separately; combine with the conjugate signs once at the end.
+    __m256d direct = _mm256_setzero_pd();
+    __m256d cross = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m256d va = _mm256_loadu_pd(reinterpret_cast<const double*>(a + i));
+        __m256d vb = _mm256_loadu_pd(reinterpret_cast<const double*>(b + i));
+        direct = _mm256_fmadd_pd(va, _mm256_movedup_pd(vb), direct);
+        cross = _mm256_fmadd_pd(_mm256_permute_pd(va, 0x5), _mm256_permute_pd(vb, 0xF), cross);
+    }
+    alignas(32) double d[4], c[4];
+    _mm256_store_pd(d, direct);
+    _mm256_store_pd(c, cross);
+    auto tail = conjugateDotScalar(a + i, b + i, n - i);
+    return {d[0] + d[2] + c[0] + c[2] + tail.real(), d[1] + d[3] - c[1] - c[3] + tail.imag()};
+}
+
+RADAR_AVX2 static std::complex<float> conjugateDotAVX2(const std::complex<float>* a, const std::complex<float>* b, size_t n) {
+    __m256 direct = _mm256_setzero_ps();
+    __m256 cross = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256 va = _mm256_loadu_ps(reinterpret_cast<const float*>(a + i));
+        __m256 vb = _mm256_loadu_ps(reinterpret_cast<const float*>(b + i));
+        direct = _mm256_fmadd_ps(va, _mm256_moveldup_ps(vb), direct);
+        cross = _mm256_fmadd_ps(_mm256_permute_ps(va, 0xB1), _mm256_movehdup_ps(vb), cross);
+    }
+    alignas(32) float d[8], c[8];
+    _mm256_store_ps(d, direct);
+    _mm256_store_ps(c, cross);
+    auto tail = conjugateDotScalar(a + i, b + i, n - i);
+    float re = tail.real(), im = tail.imag();
+    for (int k = 0; k < 8; k += 2) {
+        re += d[k] + c[k];
+        im += d[k + 1] - c[k + 1];
+    }
+    return {re, im};
+}
+
+RADAR_AVX2 static __m256d powerAVX2(const std::complex<double>* a) {
+    __m256d lo = _mm256_loadu_pd(reinterpret_cast<const double*>(a));
+    __m256d hi = _mm256_loadu_pd(reinterpret_cast<const double*>(a + 2));
+    // hadd yields (p0, p2, p1, p3); the lane permute restores sample order.
+    __m256d sums = _mm256_hadd_pd(_mm256_mul_pd(lo, lo), _mm256_mul_pd(hi, hi));
+    return _mm256_permute4x64_pd(sums, 0xD8);
+}
+
+RADAR_AVX2 static __m256 powerAVX2(const std::complex<float>* a) {
+    __m256 lo = _mm256_loadu_ps(reinterpret_cast<const float*>(a));
+    __m256 hi = _mm256_loadu_ps(reinterpret_cast<const float*>(a + 4));
+    __m256 sums = _mm256_hadd_ps(_mm256_mul_ps(lo, lo), _mm256_mul_ps(hi, hi));
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sums), 0xD8));
+}
+
+RADAR_AVX2 static void powerAVX2(const std::complex<double>* a, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, powerAVX2(a + i));
+    powerScalar(a + i, out + i, n - i);
+}
+
+RADAR_AVX2 static void powerAVX2(const std::complex<float>* a, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) _mm256_storeu_ps(out + i, powerAVX2(a + i));
+    powerScalar(a + i, out + i, n - i);
+}
+
+RADAR_AVX2 static void magnitudeAVX2(const std::complex<double>* a, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_sqrt_pd(powerAVX2(a + i)));
+    magnitudeScalar(a + i, out + i, n - i);
+}
+
+RADAR_AVX2 static void magnitudeAVX2(const std::complex<float>* a, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) _mm256_storeu_ps(out + i, _mm256_sqrt_ps(powerAVX2(a + i)));
+    magnitudeScalar(a + i, out + i, n - i);
+}
+
+RADAR_AVX2 static void scaledAddAVX2(const std::complex<double>* x, double alpha, std::complex<double>* y, size_t n) {
+    const double* xs = reinterpret_cast<const double*>(x);
+    double* ys = reinterpret_cast<double*>(y);
+    __m256d va = _mm256_set1_pd(alpha);
+    size_t i = 0;
+    for (; i + 4 <= 2 * n; i += 4) _mm256_storeu_pd(ys + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(xs + i), _mm256_loadu_pd(ys + i)));
+    scaledAddScalar(x + i / 2, alpha, y + i / 2, n - i / 2);
+}
+
+RADAR_AVX2 static void scaledAddAVX2(const std::complex<float>* x, float alpha, std::complex<float>* y, size_t n) {
+    const float* xs = reinterpret_cast<const float*>(x);
+    float* ys = reinterpret_cast<float*>(y);
+    __m256 va = _mm256_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 8 <= 2 * n; i += 8) _mm256_storeu_ps(ys + i, _mm256_fmadd_ps(va, _mm256_loadu_ps(xs + i), _mm256_loadu_ps(ys + i)));
+    scaledAddScalar(x + i / 2, alpha, y + i / 2, n - i / 2);
+}
+
+// ---- AVX-512F: 4 complex doubles / 8 complex floats per register ----
+
+#define RADAR_AVX512 __attribute__((target("avx512f")))
+// GCC 12's avx512fintrin.h seeds permutes with an undefined vector and trips this warning when inlined.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+RADAR_AVX512 static void multiplyAVX512(const std::complex<double>* a, const std::complex<double>* b, std::complex<double>* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m512d va = _mm512_loadu_pd(reinterpret_cast<const double*>(a + i));
+        __m512d vb = _mm512_loadu_pd(reinterpret_cast<const double*>(b + i));
+        __m512d cross = _mm512_mul_pd(_mm512_permute_pd(va, 0x55), _mm512_permute_pd(vb, 0xFF));
+        _mm512_storeu_pd(reinterpret_cast<double*>(out + i), _mm512_fmaddsub_pd(va, _mm512_movedup_pd(vb), cross));
+    }
+    multiplyScalar(a + i, b + i, out + i, n - i);
+}
+
+RADAR_AVX512 static void multiplyAVX512(const std::complex<float>* a, const std::complex<float>* b, std::complex<float>* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512 va = _mm512_loadu_ps(reinterpret_cast<const float*>(a + i));
+        __m512 vb = _mm512_loadu_ps(reinterpret_cast<const float*>(b + i));
+        __m512 cross = _mm512_mul_ps(_mm512_permute_ps(va, 0xB1), _mm512_movehdup_ps(vb));
+        _mm512_storeu_ps(reinterpret_cast<float*>(out + i), _mm512_fmaddsub_ps(va, _mm512_moveldup_ps(vb), cross));
+    }
+    multiplyScalar(a + i, b + i, out + i, n - i);
+}
+
+RADAR_AVX512 static std::complex<double> conjugateDotAVX512(const std::complex<double>* a, const std::complex<double>* b, size_t n) {
+    __m512d direct = _mm512_setzero_pd();
+    __m512d cross = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m512d va = _mm512_loadu_pd(reinterpret_cast<const double*>(a + i));
+        __m512d vb = _mm512_loadu_pd(reinterpret_cast<const double*>(b + i));
+        direct = _mm512_fmadd_pd(va, _mm512_movedup_pd(vb), direct);
+        cross = _mm512_fmadd_pd(_mm512_permute_pd(va, 0x55), _mm512_permute_pd(vb, 0xFF), cross);
+    }
+    alignas(64) double d[8], c[8];
+    _mm512_store_pd(d, direct);
+    _mm512_store_pd(c, cross);
+    auto tail = conjugateDotScalar(a + i, b + i, n - i);
+    double re = tail.real(), im = tail.imag();
+    for (int k = 0; k < 8; k += 2) {
+        re += d[k] + c[k];
+        im += d[k + 1] - c[k + 1];
+    }
+    return {re, im};
+}
+
+RADAR_AVX512 static std::complex<float> conjugateDotAVX512(const std::complex<float>* a, const std::complex<float>* b, size_t n) {
+    __m512 direct = _mm512_setzero_ps();
+    __m512 cross = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512 va = _mm512_loadu_ps(reinterpret_cast<const float*>(a + i));
+        __m512 vb = _mm512_loadu_ps(reinterpret_cast<const float*>(b + i));
+        direct = _mm512_fmadd_ps(va, _mm512_moveldup_ps(vb), direct);
+        cross = _mm512_fmadd_ps(_mm512_permute_ps(va, 0xB1), _mm512_movehdup_ps(vb), cross);
+    }
+    alignas(64) float d[16], c[16];
+    _mm512_store_ps(d, direct);
+    _mm512_store_ps(c, cross);
+    auto tail = conjugateDotScalar(a + i, b + i, n - i);
+    float re = tail.real(), im = tail.imag();
+    for (int k = 0; k < 16; k += 2) {
+        re += d[k] + c[k];
+        im += d[k + 1] - c[k + 1];
+    }
+    return {re, im};
+}
+
+RADAR_AVX512 static __m512d powerAVX512(const std::complex<double>* a) {
+    __m512d lo = _mm512_loadu_pd(reinterpret_cast<const double*>(a));
+    __m512d hi = _mm512_loadu_pd(reinterpret_cast<const double*>(a + 4));
+    lo = _mm512_mul_pd(lo, lo);
+    hi = _mm512_mul_pd(hi, hi);
+    lo = _mm512_add_pd(lo, _mm512_permute_pd(lo, 0x55));
+    hi = _mm512_add_pd(hi, _mm512_permute_pd(hi, 0x55));
+    const __m512i even = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+    return _mm512_permutex2var_pd(lo, even, hi);
+}
+
+RADAR_AVX512 static __m512 powerAVX512(const std::complex<float>* a) {
+    __m512 lo = _mm512_loadu_ps(reinterpret_cast<const float*>(a));
+    __m512 hi = _mm512_loadu_ps(reinterpret_cast<const float*>(a + 8));
+    lo = _mm512_mul_ps(lo, lo);
+    hi = _mm512_mul_ps(hi, hi);
+    lo = _mm512_add_ps(lo, _mm512_permute_ps(lo, 0xB1));
+    hi = _mm512_add_ps(hi, _mm512_permute_ps(hi, 0xB1));
+    const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    return _mm512_permutex2var_ps(lo, even, hi);
+}
+
+RADAR_AVX512 static void powerAVX512(const std::complex<double>* a, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, powerAVX512(a + i));
+    powerScalar(a + i, out + i, n - i);
+}
+
+RADAR_AVX512 static void powerAVX512(const std::complex<float>* a, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) _mm512_storeu_ps(out + i, powerAVX512(a + i));
+    powerScalar(a + i, out + i, n - i);
+}
+
+RADAR_AVX512 static void magnitudeAVX512(const std::complex<double>* a, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, _mm512_sqrt_pd(powerAVX512(a + i)));
+    magnitudeScalar(a + i, out + i, n - i);
+}
+
+RADAR_AVX512 static void magnitudeAVX512(const std::complex<float>* a, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) _mm512_storeu_ps(out + i, _mm512_sqrt_ps(powerAVX512(a + i)));
+    magnitudeScalar(a + i, out + i, n - i);
+}
+
+RADAR_AVX512 static void scaledAddAVX512(const std::complex<double>* x, double alpha, std::complex<double>* y, size_t n) {
+    const double* xs = reinterpret_cast<const double*>(x);
+    double* ys = reinterpret_cast<double*>(y);
+    __m512d va = _mm512_set1_pd(alpha);
+    size_t i = 0;
+    for (; i + 8 <= 2 * n; i += 8) _mm512_storeu_pd(ys + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(xs + i), _mm512_loadu_pd(ys + i)));
+    scaledAddScalar(x + i / 2, alpha, y + i / 2, n - i / 2);
+}
+
+RADAR_AVX512 static void scaledAddAVX512(const std::complex<float>* x, float alpha, std::complex<float>* y, size_t n) {
+    const float* xs = reinterpret_cast<const float*>(x);
+    float* ys = reinterpret_cast<float*>(y);
+    __m512 va = _mm512_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 16 <= 2 * n; i += 16) _mm512_storeu_ps(ys + i, _mm512_fmadd_ps(va, _mm512_loadu_ps(xs + i), _mm512_loadu_ps(ys + i)));
+    scaledAddScalar(x + i / 2, alpha, y + i / 2, n - i / 2);
+}
+
+#pragma GCC diagnostic pop
+
+template <typename T>
+static const KernelTable<T> avx2_table = {SIMDLevel::AVX2, multiplyAVX2, conjugateDotAVX2, powerAVX2, magnitudeAVX2, scaledAddAVX2};
+template <typename T>
+static const KernelTable<T> avx512_table = {SIMDLevel::AVX512, multiplyAVX512, conjugateDotAVX512, powerAVX512,
+                                            magnitudeAVX512, scaledAddAVX512};
+
+#endif
+
+#if RADAR_SIMD_NEON
+
+// ---- NEON (AArch64 baseline): de-interleaving loads give separate real and imaginary vectors ----
+
+static void multiplyNEON(const std::complex<double>* a, const std::complex<double>* b, std::complex<double>* out, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2x2_t va = vld2q_f64(reinterpret_cast<const double*>(a + i));
+        float64x2x2_t vb = vld2q_f64(reinterpret_cast<const double*>(b + i));
+        float64x2x2_t r;
+        r.val[0] = vfmsq_f64(vmulq_f64(va.val[0], vb.val[0]), va.val[1], vb.val[1]);
+        r.val[1] = vfmaq_f64(vmulq_f64(va.val[1], vb.val[0]), va.val[0], vb.val[1]);
+        vst2q_f64(reinterpret_cast<double*>(out + i), r);
+    }
+    multiplyScalar(a + i, b + i, out + i, n - i);
+}
+
+static void multiplyNEON(const std::complex<float>* a, const std::complex<float>* b, std::complex<float>* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4x2_t va = vld2q_f32(reinterpret_cast<const float*>(a + i));
+        float32x4x2_t vb = vld2q_f32(reinterpret_cast<const float*>(b + i));
+        float32x4x2_t r;
+        r.val[0] = vfmsq_f32(vmulq_f32(va.val[0], vb.val[0]), va.val[1], vb.val[1]);
+        r.val[1] = vfmaq_f32(vmulq_f32(va.val[1], vb.val[0]), va.val[0], vb.val[1]);
+        vst2q_f32(reinterpret_cast<float*>(out + i), r);
+    }
+    multiplyScalar(a + i, b + i, out + i, n - i);
+}
+
+static std::complex<double> conjugateDotNEON(const std::complex<double>* a, const std::complex<double>* b, size_t n) {
+    float64x2_t re = vdupq_n_f64(0.0), im = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2x2_t va = vld2q_f64(reinterpret_cast<const double*>(a + i));
+        float64x2x2_t vb = vld2q_f64(reinterpret_cast<const double*>(b + i));
+        re = vfmaq_f64(vfmaq_f64(re, va.val[0], vb.val[0]), va.val[1], vb.val[1]);
+        im = vfmsq_f64(vfmaq_f64(im, va.val[1], vb.val[0]), va.val[0], vb.val[1]);
+    }
+    auto tail = conjugateDotScalar(a + i, b + i, n - i);
+    return {vaddvq_f64(re) + tail.real(), vaddvq_f64(im) + tail.imag()};
+}
+
+static std::complex<float> conjugateDotNEON(const std::complex<float>* a, const std::complex<float>* b, size_t n) {
+    float32x4_t re = vdupq_n_f32(0.0f), im = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4x2_t va = vld2q_f32(reinterpret_cast<const float*>(a + i));
+        float32x4x2_t vb = vld2q_f32(reinterpret_cast<const float*>(b + i));
+        re = vfmaq_f32(vfmaq_f32(re, va.val[0], vb.val[0]), va.val[1], vb.val[1]);
+        im = vfmsq_f32(vfmaq_f32(im, va.val[1], vb.val[0]), va.val[0], vb.val[1]);
+    }
+    auto tail = conjugateDotScalar(a + i, b + i, n - i);
+    return {vaddvq_f32(re) + tail.real(), vaddvq_f32(im) + tail.imag()};
+}
+
+static void powerNEON(const std::complex<double>* a, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2x2_t va = vld2q_f64(reinterpret_cast<const double*>(a + i));
+        vst1q_f64(out + i, vfmaq_f64(vmulq_f64(va.val[0], va.val[0]), va.val[1], va.val[1]));
+    }
+    powerScalar(a + i, out + i, n - i);
+}
+
+static void powerNEON(const std::complex<float>* a, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4x2_t va = vld2q_f32(reinterpret_cast<const float*>(a + i));
+        vst1q_f32(out + i, vfmaq_f32(vmulq_f32(va.val[0], va.val[0]), va.val[1], va.val[1]));
+    }
+    powerScalar(a + i, out + i, n - i);
+}
+
+static void magnitudeNEON(const std::complex<double>* a, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2x2_t va = vld2q_f64(reinterpret_cast<const double*>(a + i));
+        vst1q_f64(out + i, vsqrtq_f64(vfmaq_f64(vmulq_f64(va.val[0], va.val[0]), va.val[1], va.val[1])));
+    }
+    magnitudeScalar(a + i, out + i, n - i);
+}
+
+static void magnitudeNEON(const std::complex<float>* a, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4x2_t va = vld2q_f32(reinterpret_cast<const float*>(a + i));
+        vst1q_f32(out + i, vsqrtq_f32(vfmaq_f32(vmulq_f32(va.val[0], va.val[0]), va.val[1], va.val[1])));
+    }
+    magnitudeScalar(a + i, out + i, n - i);
+}
+
+static void scaledAddNEON(const std::complex<double>* x, double alpha, std::complex<double>* y, size_t n) {
+    const double* xs = reinterpret_cast<const double*>(x);
+    double* ys = reinterpret_cast<double*>(y);
+    size_t i = 0;
+    for (; i + 2 <= 2 * n; i += 2) vst1q_f64(ys + i, vfmaq_n_f64(vld1q_f64(ys + i), vld1q_f64(xs + i), alpha));
+    scaledAddScalar(x + i / 2, alpha, y + i / 2, n - i / 2);
+}
+
+static void scaledAddNEON(const std::complex<float>* x, float alpha, std::complex<float>* y, size_t n) {
+    const float* xs = reinterpret_cast<const float*>(x);
+    float* ys = reinterpret_cast<float*>(y);
+    size_t i = 0;
+    for (; i + 4 <= 2 * n; i += 4) vst1q_f32(ys + i, vfmaq_n_f32(vld1q_f32(ys + i), vld1q_f32(xs + i), alpha));
+    scaledAddScalar(x + i / 2, alpha, y + i / 2, n - i / 2);
+}
+
+template <typename T>
+static const KernelTable<T> neon_table = {SIMDLevel::NEON, multiplyNEON, conjugateDotNEON, powerNEON, magnitudeNEON, scaledAddNEON};
+
+#endif
+
+template <typename T>
+static const KernelTable<T>* tableFor(SIMDLevel level) {
+    switch (level) {
+#if RADAR_SIMD_X86
+        case SIMDLevel::AVX512:
+            return __builtin_cpu_supports("avx512f") ? &avx512_table<T> : nullptr;
+        case SIMDLevel::AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") ? &avx2_table<T> : nullptr;
+#endif
+#if RADAR_SIMD_NEON
+        case SIMDLevel::NEON:
+            return &neon_table<T>;
+#endif
+        case SIMDLevel::Scalar:
+            return &scalar_table<T>;
+        default:
+            return nullptr;
+    }
+}
+
+template <typename T>
+static std::atomic<const KernelTable<T>*>& activeTable() {
+    static std::atomic<const KernelTable<T>*> table{tableFor<T>(BasicSIMDKernels<T>::detect())};
+    return table;
+}
+
+template <typename T>
+SIMDLevel BasicSIMDKernels<T>::detect() {
+    for (SIMDLevel level : {SIMDLevel::AVX512, SIMDLevel::AVX2, SIMDLevel::NEON}) {
+        if (tableFor<T>(level)) return level;
+    }
+    return SIMDLevel::Scalar;
+}
+
+template <typename T>
+SIMDLevel BasicSIMDKernels<T>::active() {
+    return activeTable<T>().load(std::memory_order_relaxed)->level;
+}
+
+template <typename T>
+bool BasicSIMDKernels<T>::setLevel(SIMDLevel level) {
+    const KernelTable<T>* table = tableFor<T>(level);
+    if (!table) return false;
+    activeTable<T>().store(table);
+    return true;
+}
+
+template <typename T>
+void BasicSIMDKernels<T>::multiply(std::span<const std::complex<T>> a, std::span<const std::complex<T>> b,
+                                   std::span<std::complex<T>> out) {
+    activeTable<T>().load(std::memory_order_relaxed)->multiply(a.data(), b.data(), out.data(), out.size());
+}
+
+template <typename T>
+std::complex<T> BasicSIMDKernels<T>::conjugateDot(std::span<const std::complex<T>> a, std::span<const std::complex<T>> b) {
+    return activeTable<T>().load(std::memory_order_relaxed)->conjugateDot(a.data(), b.data(), std::min(a.size(), b.size()));
+}
+
+template <typename T>
+void BasicSIMDKernels<T>::power(std::span<const std::complex<T>> a, std::span<T> out) {
+    activeTable<T>().load(std::memory_order_relaxed)->power(a.data(), out.data(), out.size());
+}
+
+template <typename T>
+void BasicSIMDKernels<T>::magnitude(std::span<const std::complex<T>> a, std::span<T> out) {
+    activeTable<T>().load(std::memory_order_relaxed)->magnitude(a.data(), out.data(), out.size());
+}
+
+template <typename T>
+void BasicSIMDKernels<T>::scaledAdd(std::span<const std::complex<T>> x, T alpha, std::span<std::complex<T>> y) {
+    activeTable<T>().load(std::memory_order_relaxed)->scaledAdd(x.data(), alpha, y.data(), y.size());
+}
+
+const char* simdLevelName(SIMDLevel level) {
+    switch (level) {
+        case SIMDLevel::AVX512: return "AVX-512";
+        case SIMDLevel::AVX2: return "AVX2";
+        case SIMDLevel::NEON: return "NEON";
+        default: return "scalar";
+    }
+}
+
+template class BasicSIMDKernels<float>;
+template class BasicSIMDKernels<double>;
+
+}
\ No newline at end of file
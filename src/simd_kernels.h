@@ -0,0 +1,37 @@
+#pragma once
+#include <complex>
+#include <span>
+
+namespace RadarToolkit {
+
+enum class SIMDLevel { Scalar, NEON, AVX2, AVX512 };
+
+// Complex vector kernels on interleaved (re, im) buffers. The implementation is picked once at startup
+// from the CPU's capabilities; every level produces results within rounding of the scalar reference.
+template <typename T>
+class BasicSIMDKernels {
+public:
+    // out[i] = a[i] * b[i]; out may alias a or b.
+    static void multiply(std::span<const std::complex<T>> a, std::span<const std::complex<T>> b,
+                         std::span<std::complex<T>> out);
+    // sum of a[i] * conj(b[i])
+    static std::complex<T> conjugateDot(std::span<const std::complex<T>> a, std::span<const std::complex<T>> b);
+    // out[i] = |a[i]|^2
+    static void power(std::span<const std::complex<T>> a, std::span<T> out);
+    // out[i] = |a[i]|
+    static void magnitude(std::span<const std::complex<T>> a, std::span<T> out);
+    // y[i] += alpha * x[i]
+    static void scaledAdd(std::span<const std::complex<T>> x, T alpha, std::span<std::complex<T>> y);
+
+    static SIMDLevel detect();
+    static SIMDLevel active();
+    // Forces a level (e.g. Scalar for testing); returns false if this CPU cannot run it.
+    static bool setLevel(SIMDLevel level);
+};
+
+using SIMDKernels = BasicSIMDKernels<double>;
+using SIMDKernelsF = BasicSIMDKernels<float>;
+
+const char* simdLevelName(SIMDLevel level);
+
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "stream_pipeline.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace RadarToolkit {
+
+template <typename T>
+BasicOverlapSaveFilter<T>::BasicOverlapSaveFilter(BasicReferenceSpectrum<T> reference)
+    : reference(std::move(reference)), workspace(this->reference.fft_size * sizeof(std::complex<T>)) {}
+
+template <typename T>
+std::span<const std::complex<T>> BasicOverlapSaveFilter<T>::push(std::span<const std::complex<T>> block) {
+    pending.insert(pending.end(), block.begin(), block.end());
+    size_t lookahead = reference.reference_size ? reference.reference_size - 1 : 0;
+    size_t ready = pending.size() > lookahead ? pending.size() - lookahead : 0;
+
+    output.resize(ready);
+    if (ready == 0) return {};
+    BasicSignalProcessor<T>::matchedFilter(pending, reference, output, workspace);
+    pending.erase(pending.begin(), pending.begin() + ready);
+    return output;
+}
+
+template <typename T>
+std::span<const std::complex<T>> BasicOverlapSaveFilter<T>::flush() {
+    output.resize(pending.size());
+    BasicSignalProcessor<T>::matchedFilter(pending, reference, output, workspace);
+    pending.clear();
+    return output;
+}
+
+template <typename T>
+BasicStreamingCFAR<T>::BasicStreamingCFAR(size_t guard_cells, size_t training_cells, double pfa, CFARType type)
+    : guard_cells(guard_cells), training_cells(training_cells), pfa(pfa), type(type) {}
+
+template <typename T>
+std::span<const uint64_t> BasicStreamingCFAR<T>::push(std::span<const std::complex<T>> block) {
+    size_t kept = power.size();
+    power.resize(kept + block.size());
+    BasicSIMDKernels<T>::power(block, std::span<T>(power).subspan(kept));
+    detections.clear();
+
+    size_t reach = guard_cells + training_cells;
+    if (power.size() < 2 * reach + 1) return detections;
+
+    BasicSignalProcessor<T>::cfarDetection(std::span<const T>(power), guard_cells, training_cells, pfa, type, 0, hits,
+                                           workspace);
+    for (size_t hit : hits) detections.push_back(history_start + hit);
+
+    size_t consumed = power.size() - 2 * reach;
+    power.erase(power.begin(), power.begin() + consumed);
+    history_start += consumed;
+    return detections;
+}
+
+template <typename T>
+BasicPulseAccumulator<T>::BasicPulseAccumulator(size_t samples_per_pulse, size_t pulses_per_cpi, CPIHandler handler)
+    : cpi(pulses_per_cpi, samples_per_pulse), samples_per_pulse(samples_per_pulse), pulses_per_cpi(pulses_per_cpi),
+      handler(std::move(handler)) {}
+
+template <typename T>
+void BasicPulseAccumulator<T>::push(std::span<const std::complex<T>> block) {
+    if (cpi.empty()) return;
+    while (!block.empty()) {
+        size_t take = std::min(block.size(), cpi.size() - filled);
+        std::copy(block.begin(), block.begin() + take, cpi.data() + filled);
+        filled += take;
+        block = block.subspan(take);
+        if (filled == cpi.size()) {
+            if (handler) handler(cpi, cpi_count);
+            cpi.resize(pulses_per_cpi, samples_per_pulse);
+            ++cpi_count;
+            filled = 0;
+        }
+    }
+}
+
+template <typename T>
+BasicStreamPipeline<T>::BasicStreamPipeline(std::span<const std::complex<T>> reference, const StreamConfig& config)
+    : config(config),
+      filter(BasicSignalProcessor<T>::prepareReference(reference, 0, config.range_window)),
+      cfar(config.guard_cells, config.training_cells, config.pfa, config.cfar_type),
+      accumulator(config.samples_per_pulse, config.pulses_per_cpi,
+                  [this](BasicPulseMatrix<T>& cpi, uint64_t index) {
+                      ++statistics.cpis;
+                      if (this->config.cancel_clutter && (cpi_handler || integration_handler)) mti_filter.apply(cpi);
+                      if (cpi_handler) {
+                          BasicSignalProcessor<T>::rangeDopplerMap(std::as_const(cpi), this->config.f0, this->config.fs,
+                                                                   this->config.prf, this->config.doppler_window, cpi_map,
+                                                                   cpi_workspace);
+                          BasicSignalProcessor<T>::cfarDetection2D(
+                              cpi_map, this->config.guard_cells, this->config.doppler_guard_cells,
+                              this->config.training_cells, this->config.doppler_training_cells, this->config.pfa,
+                              cpi_detections, cpi_workspace);
+                          cpi_handler(cpi_map, cpi_detections, index);
+                      }
+                      if (integration_handler) {
+                          integrator.integrate(cpi);
+                          integrator.detect(this->config.guard_cells, this->config.training_cells, this->config.pfa,
+                                            this->config.cfar_type, integrated_detections);
+                          integration_handler(integrator, integrated_detections, index);
+                      }
+                  }),
+      integrator(config.integration), mti_filter(config.mti) {}
+
+template <typename T>
+void BasicStreamPipeline<T>::process(std::span<const std::complex<T>> compressed) {
+    auto hits = cfar.push(compressed);
+    statistics.detections += hits.size();
+    if (!hits.empty() && detection_handler) detection_handler(hits);
+    accumulator.push(compressed);
+}
+
+template <typename T>
+void BasicStreamPipeline<T>::push(std::span<const std::complex<T>> block) {
+    auto start = std::chrono::steady_clock::now();
+    process(filter.push(block));
+    record(start, block.size());
+}
+
+template <typename T>
+void BasicStreamPipeline<T>::flush() {
+    auto start = std::chrono::steady_clock::now();
+    process(filter.flush());
+    record(start, 0);
+}
+
+template <typename T>
+void BasicStreamPipeline<T>::record(std::chrono::steady_clock::time_point start, size_t samples) {
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    statistics.samples += samples;
+    ++statistics.blocks;
+    statistics.total_seconds += seconds;
+    statistics.max_block_seconds = std::max(statistics.max_block_seconds, seconds);
+}
+
+template <typename T>
+bool BasicStreamPipeline<T>::run(IQStreamReader& reader) {
+    std::vector<std::complex<T>> block(std::max<size_t>(config.block_size, 1));
+    size_t got;
+    while ((got = reader.read<T>(block)) > 0) {
+        push(std::span<const std::complex<T>>(block.data(), got));
+    }
+    flush();
+    return !reader.failed();
+}
+
+template class BasicOverlapSaveFilter<float>;
+template class BasicOverlapSaveFilter<double>;
+template class BasicStreamingCFAR<float>;
+template class BasicStreamingCFAR<double>;
+template class BasicPulseAccumulator<float>;
+template class BasicPulseAccumulator<double>;
+template class BasicStreamPipeline<float>;
+template class BasicStreamPipeline<double>;
+
+}
\ No newline at end of file
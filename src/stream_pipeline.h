@@ -0,0 +1,161 @@
+#pragma once
+#include <vector>
+#include <complex>
+#include <span>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include "signal_processor.h"
+#include "pulse_matrix.h"
+#include "file_io.h"
+#include "pulse_integrator.h"
+#include "mti_filter.h"
+
+namespace RadarToolkit {
+
+// Matched filter over an unbounded stream. Each lag needs reference_size - 1 samples of look-ahead,
+// so outputs trail the input by that much until flush() zero-pads the tail.
+template <typename T>
+class BasicOverlapSaveFilter {
+public:
+    explicit BasicOverlapSaveFilter(BasicReferenceSpectrum<T> reference);
+
+    std::span<const std::complex<T>> push(std::span<const std::complex<T>> block);
+    std::span<const std::complex<T>> flush();
+
+private:
+    BasicReferenceSpectrum<T> reference;
+    std::vector<std::complex<T>> pending;
+    std::vector<std::complex<T>> output;
+    Workspace workspace;
+};
+
+// CA/GO/SO/OS-CFAR over an unbounded stream of samples. The last 2 * (guard + training) powers are
+// carried across blocks so every cell is tested exactly once, with the same window as the batch path.
+template <typename T>
+class BasicStreamingCFAR {
+public:
+    BasicStreamingCFAR(size_t guard_cells, size_t training_cells, double pfa, CFARType type = CFARType::CellAveraging);
+
+    // Returns absolute sample indices of detections completed by this block.
+    std::span<const uint64_t> push(std::span<const std::complex<T>> block);
+
+private:
+    size_t guard_cells;
+    size_t training_cells;
+    double pfa;
+    CFARType type;
+    uint64_t history_start = 0;
+    std::vector<T> power;
+    std::vector<size_t> hits;
+    std::vector<uint64_t> detections;
+    Workspace workspace;
+};
+
+// Slices a sample stream into pulses of fixed length and emits a full CPI every pulses_per_cpi pulses.
+// The handler may modify the CPI in place, or shrink it; the next pulses overwrite it at full size.
+template <typename T>
+class BasicPulseAccumulator {
+public:
+    using CPIHandler = std::function<void(BasicPulseMatrix<T>& cpi, uint64_t cpi_index)>;
+
+    BasicPulseAccumulator(size_t samples_per_pulse, size_t pulses_per_cpi, CPIHandler handler);
+    void push(std::span<const std::complex<T>> block);
+
+private:
+    BasicPulseMatrix<T> cpi;
+    size_t samples_per_pulse;
+    size_t pulses_per_cpi;
+    size_t filled = 0;
+    uint64_t cpi_count = 0;
+    CPIHandler handler;
+};
+
+struct StreamConfig {
+    size_t block_size = 65536;
+    size_t samples_per_pulse = 0;
+    size_t pulses_per_cpi = 0;
+    size_t guard_cells = 5;
+    size_t training_cells = 10;
+    size_t doppler_guard_cells = 1;
+    size_t doppler_training_cells = 2;
+    double pfa = 1e-6;
+    CFARType cfar_type = CFARType::CellAveraging;
+    double f0 = 0.0;
+    double fs = 0.0;
+    double prf = 0.0;
+    // Taper of the matched-filter reference, and of slow time in each CPI's range-Doppler map.
+    WindowSpec range_window;
+    WindowSpec doppler_window{WindowType::Hann};
+    // Used when an integration handler is set; detections on the integrated score use the CFAR settings above.
+    IntegrationConfig integration;
+    // Runs the MTI canceller (and clutter map) on every CPI ahead of the range-Doppler map and integration.
+    bool cancel_clutter = false;
+    MTIConfig mti;
+};
+
+struct StreamStats {
+    uint64_t samples = 0;
+    uint64_t blocks = 0;
+    uint64_t detections = 0;
+    uint64_t cpis = 0;
+    // Cover every push() and the final flush(), which counts as a block of its own.
+    double total_seconds = 0.0;
+    double max_block_seconds = 0.0;
+};
+
+// Block-in, detections-out pipeline: overlap-save matched filter -> streaming CFAR, with the
+// compressed stream also accumulated into CPIs for range-Doppler processing and 2-D CFAR.
+// Memory is bounded by the block size, the reference length and one CPI.
+template <typename T>
+class BasicStreamPipeline {
+public:
+    using DetectionHandler = std::function<void(std::span<const uint64_t> sample_indices)>;
+    using CPIHandler = std::function<void(const BasicRangeDopplerMap<T>& map, const std::vector<Detection2D>& detections,
+                                          uint64_t cpi_index)>;
+    using IntegrationHandler = std::function<void(const BasicPulseIntegrator<T>& integrator,
+                                                  std::span<const size_t> range_cells, uint64_t cpi_index)>;
+
+    BasicStreamPipeline(std::span<const std::complex<T>> reference, const StreamConfig& config);
+
+    void onDetections(DetectionHandler handler) { detection_handler = std::move(handler); }
+    void onCPI(CPIHandler handler) { cpi_handler = std::move(handler); }
+    // Integrates every CPI into a score carried across CPIs and reports the range cells it detects.
+    void onIntegration(IntegrationHandler handler) { integration_handler = std::move(handler); }
+
+    void push(std::span<const std::complex<T>> block);
+    void flush();
+    // Reads the source in config.block_size chunks until end of stream, then flushes. Returns false when the
+    // source failed or was truncated; the samples read before that are still processed.
+    bool run(IQStreamReader& reader);
+
+    const StreamStats& stats() const { return statistics; }
+
+private:
+    StreamConfig config;
+    BasicOverlapSaveFilter<T> filter;
+    BasicStreamingCFAR<T> cfar;
+    BasicPulseAccumulator<T> accumulator;
+    DetectionHandler detection_handler;
+    CPIHandler cpi_handler;
+    IntegrationHandler integration_handler;
+    StreamStats statistics;
+    // Reused for every CPI, so a steady stream does not allocate per CPI.
+    Workspace cpi_workspace;
+    BasicRangeDopplerMap<T> cpi_map;
+    std::vector<Detection2D> cpi_detections;
+    BasicPulseIntegrator<T> integrator;
+    std::vector<size_t> integrated_detections;
+    BasicMTIFilter<T> mti_filter;
+
+    void process(std::span<const std::complex<T>> compressed);
+    void record(std::chrono::steady_clock::time_point start, size_t samples);
+};
+
+using OverlapSaveFilter = BasicOverlapSaveFilter<double>;
+using StreamingCFAR = BasicStreamingCFAR<double>;
+using PulseAccumulator = BasicPulseAccumulator<double>;
+using StreamPipeline = BasicStreamPipeline<double>;
+using StreamPipelineF = BasicStreamPipeline<float>;
+
+}
\ No newline at end of file
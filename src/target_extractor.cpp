@@ -0,0 +1,141 @@
+#include "target_extractor.h"
+#include "metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace RadarToolkit {
+
+constexpr uint32_t NO_SLOT = ~uint32_t{0};
+
+// Offset of the peak of a parabola through the logs of three powers, so a Gaussian mainlobe is fitted exactly.
+static double peakOffset(double before, double peak, double after) {
+    if (before <= 0.0 || peak <= 0.0 || after <= 0.0) return 0.0;
+    double a = std::log(before), b = std::log(peak), c = std::log(after);
+    double curvature = a - 2.0 * b + c;
+    if (curvature >= 0.0) return 0.0;
+    return std::clamp(0.5 * (a - c) / curvature, -0.5, 0.5);
+}
+
+template <typename T>
+BasicTargetExtractor<T>::BasicTargetExtractor(const ExtractionConfig& config) : config(config) {}
+
+template <typename T>
+std::span<const TargetReport> BasicTargetExtractor<T>::extract(std::span<const std::complex<T>> signal,
+                                                               std::span<const size_t> detections,
+                                                               double range_resolution) {
+    cells.clear();
+    for (size_t index : detections) cells.push_back({index, 0});
+    cluster([signal](size_t r, size_t) { return static_cast<double>(std::norm(signal[r])); }, cells, signal.size(), 1,
+            range_resolution, 0.0);
+    return targets;
+}
+
+template <typename T>
+std::span<const TargetReport> BasicTargetExtractor<T>::extract(std::span<const T> power,
+                                                               std::span<const size_t> detections,
+                                                               double range_resolution) {
+    cells.clear();
+    for (size_t index : detections) cells.push_back({index, 0});
+    cluster([power](size_t r, size_t) { return static_cast<double>(power[r]); }, cells, power.size(), 1,
+            range_resolution, 0.0);
+    return targets;
+}
+
+template <typename T>
+std::span<const TargetReport> BasicTargetExtractor<T>::extract(const BasicRangeDopplerMap<T>& map,
+                                                               std::span<const Detection2D> detections) {
+    cluster([&map](size_t r, size_t d) {
+        double magnitude = map.at(r, d);
+        return magnitude * magnitude;
+    }, detections, map.num_range_bins, map.num_doppler_bins, map.range_resolution, map.velocity_resolution);
+    return targets;
+}
+
+template <typename T>
+template <typename Power>
+void BasicTargetExtractor<T>::cluster(const Power& power, std::span<const Detection2D> detections, size_t range_bins,
+                                      size_t doppler_bins, double range_resolution, double velocity_resolution) {
+    RADAR_METRIC_SCOPE(MetricStage::Extraction);
+    targets.clear();
+    const size_t count = detections.size();
+    if (count == 0) return;
+
+    // Union-find over the detections. Being range-major, each one only needs checking against the earlier
+    // detections within range_gap rows; the smaller index becomes the root, so targets come out in range order.
+    parent.resize(count);
+    std::iota(parent.begin(), parent.end(), 0u);
+    auto find = [&](uint32_t i) {
+        while (parent[i] != i) i = parent[i] = parent[parent[i]];
+        return i;
+    };
+    auto dopplerDistance = [doppler_bins](size_t a, size_t b) {
+        size_t distance = a > b ? a - b : b - a;
+        return std::min(distance, doppler_bins - distance);
+    };
+    size_t window = 0;
+    for (size_t i = 0; i < count; ++i) {
+        while (detections[window].range_bin + config.range_gap < detections[i].range_bin) ++window;
+        for (size_t j = window; j < i; ++j) {
+            if (dopplerDistance(detections[i].doppler_bin, detections[j].doppler_bin) > config.doppler_gap) continue;
+            uint32_t a = find(static_cast<uint32_t>(i)), b = find(static_cast<uint32_t>(j));
+            if (a != b) parent[std::max(a, b)] = std::min(a, b);
+        }
+    }
+
+    slot.assign(count, NO_SLOT);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t root = find(static_cast<uint32_t>(i));
+        if (slot[root] == NO_SLOT) {
+            slot[root] = static_cast<uint32_t>(targets.size());
+            targets.emplace_back();
+        }
+        TargetReport& target = targets[slot[root]];
+        double cell_power = power(detections[i].range_bin, detections[i].doppler_bin);
+        if (target.cells++ == 0 || cell_power > target.peak_power) {
+            target.peak_power = cell_power;
+            target.range_bin = static_cast<double>(detections[i].range_bin);
+            target.doppler_bin = static_cast<double>(detections[i].doppler_bin);
+        }
+    }
+
+    auto detected = [&](size_t r, size_t d) {
+        return std::binary_search(detections.begin(), detections.end(), Detection2D{r, d},
+                                  [](const Detection2D& a, const Detection2D& b) {
+            return a.range_bin != b.range_bin ? a.range_bin < b.range_bin : a.doppler_bin < b.doppler_bin;
+        });
+    };
+    for (TargetReport& target : targets) {
+        size_t r = static_cast<size_t>(target.range_bin);
+        size_t d = static_cast<size_t>(target.doppler_bin);
+        if (r > 0 && r + 1 < range_bins) {
+            target.range_bin += peakOffset(power(r - 1, d), target.peak_power, power(r + 1, d));
+        }
+        if (doppler_bins >= 3) {
+            target.doppler_bin += peakOffset(power(r, (d + doppler_bins - 1) % doppler_bins), target.peak_power,
+                                             power(r, (d + 1) % doppler_bins));
+        }
+        target.range = target.range_bin * range_resolution;
+        target.velocity = doppler_bins > 1
+            ? (target.doppler_bin - static_cast<double>(doppler_bins / 2)) * velocity_resolution : 0.0;
+
+        double noise = 0.0;
+        size_t training = 0;
+        for (size_t k = config.guard_cells + 1; k <= config.guard_cells + config.training_cells; ++k) {
+            if (k <= r && !detected(r - k, d)) {
+                noise += power(r - k, d);
+                ++training;
+            }
+            if (r + k < range_bins && !detected(r + k, d)) {
+                noise += power(r + k, d);
+                ++training;
+            }
+        }
+        if (training > 0 && noise > 0.0) target.snr_db = 10.0 * std::log10(target.peak_power * training / noise);
+    }
+}
+
+template class BasicTargetExtractor<float>;
+template class BasicTargetExtractor<double>;
+
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+#include <vector>
+#include <complex>
+#include <span>
+#include <cstdint>
+#include "signal_processor.h"
+
+namespace RadarToolkit {
+
+struct ExtractionConfig {
+    // Detections at most this many bins apart on both axes join one target; 1 merges touching cells,
+    // diagonals included. The Doppler axis wraps.
+    size_t range_gap = 1;
+    size_t doppler_gap = 1;
+    // Noise for the SNR estimate: training cells on each side of the peak along range, beyond guard cells,
+    // skipping cells that are detections themselves.
+    size_t guard_cells = 2;
+    size_t training_cells = 8;
+};
+
+// One target: a connected cluster of CFAR detections.
+struct TargetReport {
+    // Peak position refined by a log-parabolic (Gaussian) fit through the peak cell and its neighbours on each
+    // axis, in fractional bins and in metres and metres per second. 1-D targets have no Doppler.
+    double range_bin = 0.0;
+    double doppler_bin = 0.0;
+    double range = 0.0;
+    double velocity = 0.0;
+    double peak_power = 0.0;
+    // Peak power over the local noise estimate; 0 when no training cell is free.
+    double snr_db = 0.0;
+    size_t cells = 0;
+};
+
+// Turns the cell lists of cfarDetection and cfarDetection2D into one report per target. The reports live in
+// a buffer owned by the extractor and reused by every call, so a steady stream of CPIs does not allocate.
+template <typename T>
+class BasicTargetExtractor {
+public:
+    explicit BasicTargetExtractor(const ExtractionConfig& config = {});
+
+    // Detections must be ascending, as cfarDetection returns them; cell i lies at i * range_resolution.
+    std::span<const TargetReport> extract(std::span<const std::complex<T>> signal, std::span<const size_t> detections,
+                                          double range_resolution);
+    std::span<const TargetReport> extract(std::span<const T> power, std::span<const size_t> detections,
+                                          double range_resolution);
+    // Detections must be in range-major order, as cfarDetection2D returns them.
+    std::span<const TargetReport> extract(const BasicRangeDopplerMap<T>& map, std::span<const Detection2D> detections);
+
+    std::span<const TargetReport> reports() const { return targets; }
+
+private:
+    ExtractionConfig config;
+    std::vector<TargetReport> targets;
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> slot;
+    std::vector<Detection2D> cells;
+
+    template <typename Power>
+    void cluster(const Power& power, std::span<const Detection2D> detections, size_t range_bins, size_t doppler_bins,
+                 double range_resolution, double velocity_resolution);
+};
+
+using TargetExtractor = BasicTargetExtractor<double>;
+using TargetExtractorF = BasicTargetExtractor<float>;
+
+}
\ No newline at end of file
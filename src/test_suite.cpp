@@ -1,8 +1,30 @@
 #include "test_suite.h"
 #include "signal_generator.h"
 #include "signal_processor.h"
+#include "file_io.h"
+#include "stream_pipeline.h"
+#include "thread_pool.h"
+#include "clutter_model.h"
+#include "scene_simulator.h"
+#include "waveform_library.h"
+#include "simd_kernels.h"
+#include "benchmark.h"
+#include "metrics.h"
+#include "workspace.h"
+#include "processing_graph.h"
+#include "pulse_integrator.h"
+#include "mti_filter.h"
+#include "target_extractor.h"
+#include "signal_analyzer.h"
+#include "radar_c_api.h"
 #include <iostream>
 #include <cassert>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <filesystem>
 
 namespace RadarToolkit {
 
@@ -21,6 +43,764 @@ void TestSuite::runTests() {
     auto filtered = SignalProcessor::matchedFilter(chirp, chirp);
     assert(filtered.size() == chirp.size() && "Matched filter size mismatch");
 
+    std::vector<std::complex<double>> echo(300);
+    for (size_t i = 0; i < echo.size(); ++i) echo[i] = {std::sin(0.37 * i), std::cos(0.11 * i * i)};
+    std::vector<std::complex<double>> pulse(echo.begin() + 40, echo.begin() + 77);
+    auto direct = SignalProcessor::matchedFilterDirect(echo, pulse);
+    auto fast = SignalProcessor::matchedFilter(echo, SignalProcessor::prepareReference(pulse, 64));
+    double max_error = 0.0;
+    for (size_t i = 0; i < echo.size(); ++i) max_error = std::max(max_error, std::abs(direct[i] - fast[i]));
+    assert(max_error < 1e-9 && "FFT matched filter disagrees with direct correlation");
+
+    for (size_t n : {1, 2, 8, 32, 64, 12, 1000}) {
+        std::vector<std::complex<double>> x(n), expected(n);
+        for (size_t i = 0; i < n; ++i) x[i] = {std::cos(0.3 * i * i), std::sin(1.7 * i)};
+        for (size_t k = 0; k < n; ++k) {
+            for (size_t i = 0; i < n; ++i) {
+                double angle = -2.0 * 3.14159265358979323846 * static_cast<double>((k * i) % n) / n;
+                expected[k] += x[i] * std::complex<double>(std::cos(angle), std::sin(angle));
+            }
+        }
+        auto spectrum = x;
+        SignalProcessor::fft(spectrum);
+        double fft_error = 0.0;
+        for (size_t k = 0; k < n; ++k) fft_error = std::max(fft_error, std::abs(spectrum[k] - expected[k]));
+        assert(fft_error < 1e-9 * n && "FFT disagrees with direct DFT");
+
+        SignalProcessor::fft(spectrum, true);
+        double round_trip_error = 0.0;
+        for (size_t i = 0; i < n; ++i) round_trip_error = std::max(round_trip_error, std::abs(spectrum[i] / double(n) - x[i]));
+        assert(round_trip_error < 1e-12 * n && "Inverse FFT round trip failed");
+    }
+
+    PulseMatrix cpi(16, 64);
+    for (size_t p = 0; p < cpi.numPulses(); ++p) {
+        double phase = 2.0 * 3.14159265358979323846 * 250.0 * p / 1000.0;
+        cpi(p, 5) = {std::cos(phase), std::sin(phase)};
+    }
+    assert(cpi.column(5)[3] == cpi.row(3)[5] && reinterpret_cast<uintptr_t>(cpi.data()) % 64 == 0);
+    SplitPulseMatrix split(cpi);
+    assert(split.real(4)[5] == cpi(4, 5).real() && split.imag(4)[5] == cpi(4, 5).imag() && "Split layout mismatch");
+    auto rd_map = SignalProcessor::rangeDopplerMap(cpi, 1e9, 1e6, 1000.0);
+    assert(rd_map.num_range_bins == 64 && rd_map.num_doppler_bins == 16 && rd_map.data.size() == 64 * 16);
+    auto rd_peak = std::max_element(rd_map.data.begin(), rd_map.data.end()) - rd_map.data.begin();
+    assert(rd_peak / 16 == 5 && rd_peak % 16 == 12 && "Range-Doppler peak in wrong cell");
+    assert(std::abs(rd_map.velocity(12) - 250.0 * 3.0e8 / (2.0 * 1e9)) < 1e-9 && "Doppler axis scaling wrong");
+
+    std::vector<double> clutter_floor(200);
+    for (size_t i = 0; i < clutter_floor.size(); ++i) clutter_floor[i] = 1.0 + 0.5 * std::sin(0.7 * i);
+    clutter_floor[120] = 500.0;
+    for (auto type : {CFARType::CellAveraging, CFARType::GreatestOf, CFARType::SmallestOf, CFARType::OrderStatistic}) {
+        auto hits = SignalProcessor::cfarDetection(clutter_floor, 2, 8, 1e-6, type);
+        assert(hits.size() == 1 && hits[0] == 120 && "CFAR variant missed the target or false alarmed");
+    }
+    assert(SignalProcessor::cfarDetection(std::vector<double>(10, 1.0), 5, 10, 1e-6).empty() && "CFAR on short input");
+    double ca_factor = SignalProcessor::cfarThresholdFactor(CFARType::CellAveraging, 8, 1e-4);
+    assert(std::abs(ca_factor - 16.0 * (std::pow(1e-4, -1.0 / 16.0) - 1.0)) < 1e-12);
+    assert(SignalProcessor::cfarThresholdFactor(CFARType::GreatestOf, 8, 1e-4) < ca_factor);
+    assert(SignalProcessor::cfarThresholdFactor(CFARType::SmallestOf, 8, 1e-4) > ca_factor);
+
+    RangeDopplerMap flat_map;
+    flat_map.num_range_bins = 40;
+    flat_map.num_doppler_bins = 16;
+    flat_map.data.assign(40 * 16, 1.0);
+    flat_map.data[20 * 16 + 7] = 40.0;
+    auto hits_2d = SignalProcessor::cfarDetection2D(flat_map, 1, 1, 3, 2, 1e-6);
+    assert(hits_2d.size() == 1 && hits_2d[0].range_bin == 20 && hits_2d[0].doppler_bin == 7 && "2-D CFAR failed");
+
+    auto chirp_f = SignalGeneratorF::generateChirp(1e9, 100e6, 1e-6, 1e9);
+    auto spectrum_f = SignalProcessorF::prepareReference(chirp_f);
+    auto compressed_f = SignalProcessorF::matchedFilter(chirp_f, spectrum_f);
+    auto compressed_d = SignalProcessor::matchedFilter(chirp, SignalProcessor::prepareReference(chirp));
+    double float_error = 0.0;
+    for (size_t i = 0; i < chirp.size(); ++i) {
+        float_error = std::max(float_error, std::abs(std::complex<double>(compressed_f[i]) - compressed_d[i]));
+    }
+    assert(float_error < 1e-3 * std::abs(compressed_d[0]) && "Single-precision matched filter diverges from double");
+
+    std::vector<int16_t> adc = {16384, -16384, 0, 32767};
+    auto ingested = FileIOF::convertIQ16(adc);
+    assert(ingested.size() == 2 && ingested[0] == std::complex<float>(0.5f, -0.5f) && "int16 IQ conversion failed");
+
+    PulseMatrix stored(3, 50);
+    for (size_t i = 0; i < stored.size(); ++i) stored.data()[i] = {std::sin(0.1 * i), std::cos(0.2 * i)};
+    IQFileHeader stored_meta;
+    stored_meta.fs = 2e6;
+    bool saved = FileIO::saveBinary(stored, "test_suite_roundtrip.iq", stored_meta);
+    assert(saved && "Binary save failed");
+    {
+        MappedIQFile mapped;
+        bool mapped_ok = mapped.open("test_suite_roundtrip.iq");
+        assert(mapped_ok && mapped.header().num_pulses == 3 && mapped.header().fs == 2e6);
+        assert(mapped.pulse<double>(2)[7] == stored(2, 7) && "Mapped view mismatch");
+        assert(mapped.pulse<double>(3).empty() && mapped.pulse<float>(0).empty() && "Mapped view out of bounds");
+
+        IQStreamReader reader;
+        bool reader_ok = reader.open("test_suite_roundtrip.iq");
+        assert(reader_ok && "Streaming reader failed to open");
+        std::vector<std::complex<float>> chunk(64);
+        size_t total = 0, got;
+        while ((got = reader.read<float>(chunk)) > 0) total += got;
+        assert(total == stored.size() && !reader.failed() && "Streaming reader lost samples");
+
+        // A file cut short of its header's sample count reads what is there and reports the truncation.
+        std::filesystem::copy_file("test_suite_roundtrip.iq", "test_suite_truncated.iq",
+                                   std::filesystem::copy_options::overwrite_existing);
+        std::filesystem::resize_file("test_suite_truncated.iq",
+                                     std::filesystem::file_size("test_suite_truncated.iq") - 10 * sizeof(stored(0, 0)));
+        IQStreamReader truncated;
+        reader_ok = truncated.open("test_suite_truncated.iq");
+        assert(reader_ok);
+        total = 0;
+        while ((got = truncated.read<float>(chunk)) > 0) total += got;
+        assert(total == stored.size() - 10 && truncated.failed() && "Truncated stream not reported");
+    }
+    std::remove("test_suite_roundtrip.iq");
+    std::remove("test_suite_truncated.iq");
+
+    auto stream_input = chirp;
+    stream_input.resize(3000);
+    stream_input.insert(stream_input.begin() + 1200, chirp.begin(), chirp.end());
+    SignalGenerator::addNoise(stream_input, 10.0);
+    auto batch_compressed = SignalProcessor::matchedFilter(stream_input, SignalProcessor::prepareReference(chirp));
+    auto batch_hits = SignalProcessor::cfarDetection(batch_compressed, 12, 10, 1e-6);
+    assert(!batch_hits.empty());
+    StreamConfig stream_config;
+    stream_config.guard_cells = 12;
+    stream_config.samples_per_pulse = 100;
+    stream_config.pulses_per_cpi = 8;
+    for (size_t block : {1, 37, 512, 5000}) {
+        StreamPipeline pipeline(chirp, stream_config);
+        std::vector<uint64_t> stream_hits;
+        pipeline.onDetections([&](std::span<const uint64_t> hits) {
+            stream_hits.insert(stream_hits.end(), hits.begin(), hits.end());
+        });
+        size_t integrated_cpis = 0;
+        pipeline.onIntegration([&](const PulseIntegrator& integrator, std::span<const size_t>, uint64_t index) {
+            assert(integrator.cpis() == index + 1);
+            integrated_cpis = integrator.cpis();
+        });
+        for (size_t start = 0; start < stream_input.size(); start += block) {
+            pipeline.push(std::span(stream_input).subspan(start, std::min(block, stream_input.size() - start)));
+        }
+        pipeline.flush();
+        assert(std::equal(stream_hits.begin(), stream_hits.end(), batch_hits.begin(), batch_hits.end()) &&
+               "Streaming detections differ from batch");
+        assert(pipeline.stats().samples == stream_input.size() && pipeline.stats().cpis == 5 && integrated_cpis == 5);
+    }
+
+    // The configured windows reach the stream's filter and CPI maps, so a tapered stream matches the batch path.
+    stream_config.range_window = {WindowType::Taylor};
+    stream_config.doppler_window = {WindowType::Kaiser};
+    auto tapered_compressed =
+        SignalProcessor::matchedFilter(stream_input, SignalProcessor::prepareReference(chirp, 0, stream_config.range_window));
+    PulseMatrix tapered_cpi(8, 100);
+    std::copy_n(tapered_compressed.begin(), tapered_cpi.size(), tapered_cpi.data());
+    auto tapered_map = SignalProcessor::rangeDopplerMap(tapered_cpi, 0.0, 0.0, 0.0, stream_config.doppler_window);
+    double tapered_error = -1.0;
+    StreamPipeline tapered(chirp, stream_config);
+    tapered.onCPI([&](const RangeDopplerMap& map, const std::vector<Detection2D>&, uint64_t index) {
+        if (index != 0) return;
+        tapered_error = 0.0;
+        for (size_t i = 0; i < map.data.size(); ++i) {
+            tapered_error = std::max(tapered_error, std::abs(map.data[i] - tapered_map.data[i]));
+        }
+    });
+    tapered.push(stream_input);
+    tapered.flush();
+    assert(tapered_error >= 0.0 && tapered_error < 1e-9 && "Streaming windows differ from batch");
+
+    ThreadPool pool(4);
+    std::vector<int> visits(1000, 0);
+    pool.parallelFor(visits.size() / 10, [&](size_t begin, size_t end) {
+        for (size_t outer = begin; outer < end; ++outer) {
+            pool.parallelFor(10, [&](size_t b, size_t e) {
+                for (size_t inner = b; inner < e; ++inner) ++visits[outer * 10 + inner];
+            });
+        }
+    });
+    assert(std::all_of(visits.begin(), visits.end(), [](int v) { return v == 1; }) && "Pool skipped or repeated work");
+
+    std::vector<std::complex<double>> seeded_a(64, 1.0), seeded_b(64, 1.0);
+    SignalGenerator::addNoise(seeded_a, 0.0, RandomStream(42));
+    SignalGenerator::addNoise(seeded_b, 0.0, RandomStream(42));
+    assert(seeded_a == seeded_b && "Seeded noise is not reproducible");
+    auto philox = Philox4x32::generate({0, 0, 0, 0}, 0);
+    assert(philox[0] == 0x6627e8d5 && philox[3] == 0x9b00dbd8 && "Philox known-answer mismatch");
+    std::vector<double> gaussian(1000), gaussian_tail(999);
+    RandomStream(7).fillGaussian<double>(gaussian, 1.0);
+    RandomStream(7).fillGaussian<double>(gaussian_tail, 1.0, 1);
+    assert(std::equal(gaussian_tail.begin(), gaussian_tail.end(), gaussian.begin() + 1) && "Stream offset mismatch");
+
+    ClutterModel spiky;
+    spiky.amplitude = ClutterAmplitude::KDistributed;
+    spiky.shape = 0.5;
+    std::vector<std::complex<double>> k_clutter(100000, 1.0);
+    ClutterGenerator::addClutter(k_clutter, 0.0, spiky, RandomStream(5));
+    double k_power = 0.0, k_fourth = 0.0;
+    for (const auto& s : k_clutter) {
+        double power = std::norm(s - 1.0);
+        k_power += power / k_clutter.size();
+        k_fourth += power * power / k_clutter.size();
+    }
+    // Intensity moment ratio of K clutter is 2 (1 + 1/nu); Rayleigh would give 2.
+    assert(std::abs(k_power - 1.0) < 0.1 && k_fourth / (k_power * k_power) > 4.0 && "K clutter statistics wrong");
+
+    ClutterModel moving;
+    moving.spectrum = ClutterSpectrum::Gaussian;
+    moving.doppler_center = 2500.0;
+    moving.doppler_spread = 200.0;
+    PulseMatrix clutter_cpi(32, 256);
+    clutter_cpi.fill(1.0);
+    ClutterGenerator::addClutter(clutter_cpi, 20.0, moving, 10e3, RandomStream(9));
+    auto clutter_map = SignalProcessor::rangeDopplerMap(clutter_cpi, 1e9, 1e6, 10e3);
+    std::vector<double> doppler_profile(32, 0.0);
+    for (size_t r = 0; r < clutter_map.num_range_bins; ++r) {
+        for (size_t d = 1; d < 32; ++d) doppler_profile[d] += clutter_map.at(r, d);
+    }
+    auto clutter_peak = std::max_element(doppler_profile.begin(), doppler_profile.end()) - doppler_profile.begin();
+    assert(std::abs(static_cast<int>(clutter_peak) - 24) <= 1 && "Clutter Doppler spectrum not centred");
+
+    auto scene_chirp = SignalGenerator::generateChirp(0.0, 0.5e6, 20e-6, 1e6);
+    std::vector<Target> scene_targets = {{1500.0, 37.5, 1.0}, {4500.0, -18.75, 4.0}};
+    SceneConfig scene;
+    scene.fs = 1e6;
+    scene.prf = 1000.0;
+    scene.num_pulses = 16;
+    PulseMatrix scene_cpi;
+    SceneSimulator::simulate(scene_chirp, scene_targets, scene, scene_cpi);
+    assert(scene_cpi.numSamples() == 30 + scene_chirp.size() && "Receive window should end after the farthest echo");
+    auto scene_map = SignalProcessor::rangeDopplerMap(scene_cpi, SignalProcessor::prepareReference(scene_chirp), 1e9, 1e6, 1000.0);
+    auto scene_peak = std::max_element(scene_map.data.begin(), scene_map.data.end()) - scene_map.data.begin();
+    assert(scene_peak / 16 == 30 && scene_peak % 16 == 6 && "Strong target misplaced");
+    assert(scene_map.at(10, 12) > 0.1 * scene_map.data[scene_peak] && scene_map.at(10, 8) < 0.01 * scene_map.at(10, 12));
+
+    WaveformParams lfm{WaveformType::LFM, 1e9, 100e6, 20e-6, 1e9};
+    auto lfm_waveform = WaveformLibrary::get(lfm);
+    assert(WaveformLibrary::get(lfm) == lfm_waveform && "Waveform cache miss");
+    double recurrence_error = 0.0;
+    for (size_t i = 0; i < lfm_waveform->samples.size(); i += 97) {
+        double t = i / 1e9;
+        double phase = 2.0 * 3.14159265358979323846 * (1e9 * t + 0.5 * 100e6 / 20e-6 * t * t);
+        recurrence_error = std::max(recurrence_error, std::abs(lfm_waveform->samples[i] - std::polar(1.0, phase)));
+    }
+    assert(recurrence_error < 1e-9 && "Chirp phase recurrence drifted");
+    auto oversampled = SignalGenerator::generateBarkerCode(11, 1e9, 100e6);
+    assert(oversampled.size() == 110 && oversampled[9] == oversampled[0] && oversampled[30] == -oversampled[0]);
+    for (auto type : {WaveformType::Frank, WaveformType::P1, WaveformType::P2, WaveformType::P3, WaveformType::P4}) {
+        WaveformParams code;
+        code.type = type;
+        code.code_length = type == WaveformType::P3 || type == WaveformType::P4 ? 16 : 4;
+        auto chips = WaveformLibrary::get(code)->samples;
+        std::vector<std::complex<double>> echo(3 * chips.size());
+        std::copy(chips.begin(), chips.end(), echo.begin() + chips.size());
+        auto response = SignalProcessor::matchedFilter(echo, chips);
+        double sidelobe = 0.0;
+        for (size_t i = 0; i < response.size(); ++i) {
+            if (i != chips.size()) sidelobe = std::max(sidelobe, std::abs(response[i]));
+        }
+        assert(std::abs(std::abs(response[chips.size()]) - 16.0) < 1e-9 && sidelobe < 2.0 && "Polyphase code sidelobes too high");
+    }
+
+    auto hann = WindowFunction::get({WindowType::Hann}, 64);
+    assert(WindowFunction::get({WindowType::Hann}, 64) == hann && "Window table not cached");
+    auto hann_loss = WindowFunction::loss(*hann);
+    assert(std::abs(hann_loss.enbw_bins - 1.5) < 0.05 && std::abs(hann_loss.scalloping_loss_db - 1.42) < 0.1);
+    auto rect_loss = WindowFunction::loss(*WindowFunction::get({}, 64));
+    assert(rect_loss.processing_loss_db == 0.0 && std::abs(rect_loss.scalloping_loss_db - 3.92) < 0.01);
+
+    // Range sidelobes a few cells from the peak: about -18 dB untapered, below -34 dB with a 45 dB Taylor taper.
+    auto lfm_pulse = SignalGenerator::generateChirp(0.0, 50e6, 2e-6, 100e6);
+    std::vector<std::complex<double>> lfm_echo(600);
+    std::copy(lfm_pulse.begin(), lfm_pulse.end(), lfm_echo.begin() + 100);
+    auto tapered_ref = SignalProcessor::prepareReference(lfm_pulse, 0, {WindowType::Taylor, 45.0});
+    auto near_sidelobe = [&](const ReferenceSpectrum& ref) {
+        auto y = SignalProcessor::matchedFilter(lfm_echo, ref);
+        double peak = 0.0;
+        for (size_t i = 105; i < 120; ++i) peak = std::max(peak, std::abs(y[i]));
+        return peak / std::abs(y[100]);
+    };
+    assert(near_sidelobe(SignalProcessor::prepareReference(lfm_pulse)) > 0.1 && near_sidelobe(tapered_ref) < 0.02);
+    assert(tapered_ref.window_loss.processing_loss_db > 0.0 && "Taper loss not reported");
+
+    // Every dispatch level this CPU supports must match the scalar kernels to within rounding, tails included.
+    SIMDLevel detected = SIMDKernels::detect();
+    std::vector<std::complex<double>> lhs(37), rhs(37);
+    RandomStream(11).addComplexGaussian<double>(lhs, 1.0);
+    RandomStream(12).addComplexGaussian<double>(rhs, 1.0);
+    auto runKernels = [&](SIMDLevel level) {
+        SIMDKernels::setLevel(level);
+        std::vector<std::complex<double>> product(lhs.size()), accumulated(rhs);
+        std::vector<double> power(lhs.size()), magnitude(lhs.size());
+        SIMDKernels::multiply(lhs, rhs, product);
+        SIMDKernels::power(lhs, power);
+        SIMDKernels::magnitude(lhs, magnitude);
+        SIMDKernels::scaledAdd(lhs, 0.25, accumulated);
+        return std::make_tuple(product, power, magnitude, accumulated, SIMDKernels::conjugateDot(lhs, rhs));
+    };
+    auto [product_ref, power_ref, magnitude_ref, accumulated_ref, dot_ref] = runKernels(SIMDLevel::Scalar);
+    for (auto level : {SIMDLevel::NEON, SIMDLevel::AVX2, SIMDLevel::AVX512}) {
+        if (!SIMDKernels::setLevel(level)) continue;
+        auto [product, power, magnitude, accumulated, dot] = runKernels(level);
+        double kernel_error = std::abs(dot - dot_ref);
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            kernel_error = std::max({kernel_error, std::abs(product[i] - product_ref[i]), std::abs(power[i] - power_ref[i]),
+                                     std::abs(magnitude[i] - magnitude_ref[i]), std::abs(accumulated[i] - accumulated_ref[i])});
+        }
+        assert(kernel_error < 1e-12 && "SIMD kernel disagrees with scalar reference");
+    }
+    SIMDKernels::setLevel(detected);
+    std::cout << "SIMD kernels: " << simdLevelName(SIMDKernels::active()) << "\n";
+
+    BenchmarkOptions bench_options;
+    bench_options.min_size = bench_options.max_size = 1024;
+    bench_options.min_time = 0.0;
+    bench_options.filter = "fft<double>";
+    auto bench_results = Benchmark::run(Benchmark::standardSuite(), bench_options);
+    assert(bench_results.size() == 1 && bench_results[0].name == "fft<double>/1024/threads:1" &&
+           bench_results[0].gflops > 0.0);
+    bool bench_saved = Benchmark::saveJSON(bench_results, "test_benchmark.json");
+    assert(bench_saved && "Benchmark JSON save failed");
+    auto bench_baseline = Benchmark::loadJSON("test_benchmark.json");
+    std::remove("test_benchmark.json");
+    assert(bench_baseline.size() == 1 && bench_baseline[0].name == bench_results[0].name &&
+           std::abs(bench_baseline[0].samples_per_second / bench_results[0].samples_per_second - 1.0) < 1e-6);
+    bench_baseline[0].samples_per_second *= 2.0;
+    auto bench_comparison = Benchmark::compare(bench_baseline, bench_results, 0.1);
+    assert(bench_comparison.size() == 1 && bench_comparison[0].regression && "Halved throughput not flagged");
+
+    for (uint64_t ns : {0ull, 15ull, 16ull, 1000ull, 123456789ull, 1ull << 50}) {
+        size_t bucket = LatencyBuckets::index(ns);
+        assert(bucket < LatencyBuckets::COUNT && LatencyBuckets::lowerBound(bucket) <= std::min<uint64_t>(ns, 1ull << 44));
+        assert((ns >= (1ull << 44) || ns < LatencyBuckets::upperBound(bucket)) && "Latency bucket misplaced");
+    }
+#ifdef RADAR_ENABLE_METRICS
+    Metrics::reset();
+    auto metered = SignalProcessor::matchedFilter(lhs, rhs);
+    auto stage_metrics = Metrics::snapshot();
+    auto metered_filter = std::find_if(stage_metrics.begin(), stage_metrics.end(),
+                                       [](const StageMetrics& m) { return m.stage == MetricStage::MatchedFilter; });
+    assert(metered_filter != stage_metrics.end() && metered_filter->calls == 1 && metered_filter->allocations > 0 &&
+           "Nested matched filter scopes must count once");
+    assert(Metrics::toPrometheus(stage_metrics).find("radar_stage_calls_total{stage=\"matched_filter\"} 1") != std::string::npos);
+#endif
+
+    {
+        // Steady-state CPI through the workspace overloads: same results as the allocating API, and no heap
+        // traffic after the first CPI. Allocations are only counted in the metrics build.
+        ThreadPool cpi_pool(3);
+        ThreadPool::Scope cpi_scope(cpi_pool);
+        auto cpi_waveform = SignalGenerator::generateChirp(0.0, 20e6, 2e-6, 100e6);
+        auto cpi_reference = SignalProcessor::prepareReference(cpi_waveform);
+        BasicPulseMatrix<double> cpi_input(16, 512), cpi;
+        RandomStream(21).addComplexGaussian<double>(cpi_input.samples(), 0.1);
+        for (size_t p = 0; p < cpi_input.numPulses(); ++p) {
+            for (size_t i = 0; i < cpi_waveform.size(); ++i) cpi_input.row(p)[120 + i] += cpi_waveform[i];
+        }
+        Workspace cpi_workspace(SignalProcessor::workspaceBytes(cpi_reference, 16, 512));
+        RangeDopplerMap cpi_map;
+        std::vector<Detection2D> cpi_hits;
+        std::vector<size_t> range_hits;
+        auto runCPI = [&] {
+            cpi = cpi_input;
+            SignalProcessor::rangeDopplerMap(cpi, cpi_reference, 1e9, 100e6, 1e3, {WindowType::Hann}, cpi_map, cpi_workspace);
+            SignalProcessor::cfarDetection2D(cpi_map, 2, 1, 4, 2, 1e-6, cpi_hits, cpi_workspace);
+            SignalProcessor::cfarDetection(cpi.row(0), 3, 8, 1e-6, CFARType::OrderStatistic, 0, range_hits, cpi_workspace);
+        };
+        runCPI();
+#ifdef RADAR_ENABLE_METRICS
+        uint64_t allocations_before = Metrics::processAllocations();
+        runCPI();
+        runCPI();
+        assert(Metrics::processAllocations() == allocations_before && "Steady-state CPI touched the heap");
+#else
+        runCPI();
+        std::cout << "Steady-state allocation check skipped: build with -DRADAR_ENABLE_METRICS to count allocations.\n";
+#endif
+        assert(cpi_workspace.highWater() <= cpi_workspace.capacity());
+
+        BasicPulseMatrix<double> legacy_cpi = cpi_input;
+        auto legacy_map = SignalProcessor::rangeDopplerMap(legacy_cpi, cpi_reference, 1e9, 100e6, 1e3);
+        assert(legacy_map.data == cpi_map.data && !cpi_hits.empty() &&
+               SignalProcessor::cfarDetection2D(legacy_map, 2, 1, 4, 2, 1e-6).size() == cpi_hits.size());
+        assert(SignalProcessor::cfarDetection(legacy_cpi.row(0), 3, 8, 1e-6, CFARType::OrderStatistic) == range_hits &&
+               !range_hits.empty());
+    }
+
+    {
+        // The INI and JSON forms of a graph parse to the same config, plan the matched filter on its own because a
+        // CFAR stage reads the compressed pulses, and find the target.
+        const char* ini = "[radar]\nfs = 100e6\nbandwidth = 20e6\nduration = 2e-6\nprf = 10e3\npulses = 16\n"
+                          "[pipeline]\nstages = scene, noise, matched_filter, cfar, rd_map, cfar2d ; comment\njobs = 2\n"
+                          "[cfar] ; detector\ntype = os\npfa = 1e-6\n[target]\nrange = 1500\nvelocity = 93.75\n"
+                          "[scenario]\nsnr = 20\n[scenario]\nsnr = 15\n";
+        const char* json = R"({"radar": {"fs": 100e6, "bandwidth": 20e6, "duration": 2e-6, "prf": 10e3, "pulses": 16},
+            "pipeline": {"stages": ["scene", "noise", "matched_filter", "cfar", "rd_map", "cfar2d"], "jobs": 2},
+            "cfar": {"type": "os", "pfa": 1e-6}, "targets": [{"range": 1500, "velocity": 93.75}],
+            "scenarios": [{"snr": 20}, {"snr": 15}]})";
+        GraphConfig from_ini, from_json;
+        std::string error;
+        bool parsed = ProcessingGraph::parse(ini, from_ini, error) && ProcessingGraph::parse(json, from_json, error);
+        assert(parsed && "Graph parse failed");
+        assert(from_ini.stages == from_json.stages && from_ini.scenarios.size() == 2 && from_json.scenarios.size() == 2 &&
+               from_ini.targets.size() == 1 && from_json.targets[0].velocity == 93.75 &&
+               from_json.cfar_type == CFARType::OrderStatistic && from_ini.waveform == from_json.waveform);
+        bool valid = ProcessingGraph::validate(from_json, error);
+        assert(valid && "Graph validation failed");
+        assert(ProcessingGraph::describe(ProcessingGraph::plan(from_json)) ==
+               "scene -> noise -> matched_filter -> cfar -> rd_map -> cfar2d");
+        GraphConfig fusable = from_json;
+        fusable.stages = {GraphStage::Scene, GraphStage::Noise, GraphStage::MatchedFilter, GraphStage::RangeDopplerMap,
+                          GraphStage::CFAR2D};
+        assert(ProcessingGraph::describe(ProcessingGraph::plan(fusable)) ==
+               "scene -> noise -> matched_filter+rd_map -> cfar2d");
+        fusable.output = GraphOutput::CSV;
+        assert(ProcessingGraph::describe(ProcessingGraph::plan(fusable)) ==
+               "scene -> noise -> matched_filter -> rd_map -> cfar2d");
+
+        // The fused pass leaves the pulses alone and builds the map the two-pass chain does, including the
+        // partial overlap-save block at the end of each pulse.
+        auto fused_waveform = SignalGenerator::generateChirp(0.0, 20e6, 2e-6, 100e6);
+        auto fused_reference = SignalProcessor::prepareReference(fused_waveform, 512);
+        PulseMatrix fused_cpi(12, 1000);
+        RandomStream(31).addComplexGaussian<double>(fused_cpi.samples(), 0.1);
+        for (size_t i = 0; i < fused_waveform.size(); ++i) fused_cpi.row(5)[400 + i] += fused_waveform[i];
+        PulseMatrix compressed = fused_cpi;
+        Workspace fused_workspace(SignalProcessor::workspaceBytes(fused_reference, 12, 1000));
+        RangeDopplerMap two_pass, fused;
+        SignalProcessor::rangeDopplerMap(compressed, fused_reference, 1e9, 100e6, 1e3, {WindowType::Hann}, two_pass,
+                                         fused_workspace);
+        SignalProcessor::fusedRangeDopplerMap(fused_cpi, fused_reference, 1e9, 100e6, 1e3, {WindowType::Hann}, fused,
+                                              fused_workspace);
+        assert(fused.data.size() == two_pass.data.size() && fused.num_range_bins == 1000 &&
+               fused.doppler_window_loss.enbw_bins == two_pass.doppler_window_loss.enbw_bins);
+        double fused_error = 0.0, fused_peak = 0.0;
+        for (size_t i = 0; i < fused.data.size(); ++i) {
+            fused_error = std::max(fused_error, std::abs(fused.data[i] - two_pass.data[i]));
+            fused_peak = std::max(fused_peak, two_pass.data[i]);
+        }
+        assert(fused_error <= 1e-12 * fused_peak && "Fused range-Doppler map differs from the two-pass map");
+        assert(fused_cpi.row(5)[400] != compressed.row(5)[400] && fused_workspace.highWater() <= fused_workspace.capacity());
+
+        GraphConfig broken = from_json;
+        parsed = ProcessingGraph::parse("[radar]\nfs = fast\n", broken, error);
+        assert(!parsed && error.find("radar.fs") != std::string::npos);
+        broken.stages = {GraphStage::Scene, GraphStage::CFAR2D, GraphStage::RangeDopplerMap};
+        valid = ProcessingGraph::validate(broken, error);
+        assert(!valid);
+
+        std::vector<GraphResult> graph_results;
+        GraphRunner(from_json).run([&](size_t index, const GraphResult& result) {
+            assert(index == graph_results.size());
+            graph_results.push_back(result);
+        });
+        assert(graph_results.size() == 2 && graph_results[0].range_detections > 0);
+        assert(std::any_of(graph_results[0].detections.begin(), graph_results[0].detections.end(), [](const GraphDetection& hit) {
+            return std::abs(hit.range - 1500.0) < 10.0 && std::abs(hit.velocity - 93.75) < 1.0;
+        }) && "Graph run missed the target");
+    }
+
+    {
+        // A 3 dB target is lost by single-pulse CFAR but found after integrating 32 pulses; a 0 dB target with
+        // Doppler is found by the coherent bank in its own bin; a target walking one cell per CPI builds up only
+        // when the track-before-detect recursion may follow it.
+        const size_t looks = 32, cells = 512, cell = 200;
+        auto noisyCPI = [&](uint64_t seed) {
+            PulseMatrix cpi(looks, cells);
+            RandomStream(seed).addComplexGaussian<double>(cpi.samples(), std::sqrt(0.5));
+            return cpi;
+        };
+        PulseMatrix weak = noisyCPI(31);
+        for (size_t p = 0; p < looks; ++p) weak.row(p)[cell] += std::sqrt(2.0);
+        std::vector<size_t> integrated_hits;
+        PulseIntegrator noncoherent({IntegrationMode::NonCoherent});
+        noncoherent.integrate(weak);
+        noncoherent.detect(4, 16, 1e-6, CFARType::CellAveraging, integrated_hits);
+        auto single_pulse = SignalProcessor::cfarDetection(weak.row(0), 4, 16, 1e-6);
+        assert(std::find(single_pulse.begin(), single_pulse.end(), cell) == single_pulse.end());
+        assert(std::find(integrated_hits.begin(), integrated_hits.end(), cell) != integrated_hits.end() &&
+               integrated_hits.size() <= 2 && "Non-coherent integration missed the target");
+
+        PulseMatrix moving = noisyCPI(32);
+        for (size_t p = 0; p < looks; ++p) moving.row(p)[cell] += std::polar(1.0, 2.0 * M_PI * 5.0 * p / looks);
+        PulseIntegrator coherent({IntegrationMode::Coherent});
+        coherent.integrate(moving);
+        coherent.detect(4, 16, 1e-6, CFARType::CellAveraging, integrated_hits);
+        assert(std::find(integrated_hits.begin(), integrated_hits.end(), cell) != integrated_hits.end() &&
+               coherent.dopplerBins()[cell] == 5 && std::abs(moving.row(5)[cell]) > 10.0);
+
+        PulseMatrix strong = noisyCPI(33);
+        for (size_t p = 0; p < looks; ++p) strong.row(p)[cell] += std::sqrt(8.0);
+        PulseIntegrator binary({IntegrationMode::Binary});
+        binary.integrate(strong);
+        binary.detect(0, 0, 0.0, CFARType::CellAveraging, integrated_hits);
+        assert(integrated_hits == std::vector<size_t>{cell} && "M-of-N missed the target or let noise through");
+
+        IntegrationConfig walking;
+        walking.range_walk = 1;
+        PulseIntegrator tracked(walking), fixed({IntegrationMode::NonCoherent});
+        for (size_t k = 0; k < 4; ++k) {
+            PulseMatrix cpi = noisyCPI(40 + k);
+            for (size_t p = 0; p < looks; ++p) cpi.row(p)[cell + k] += 1.0;
+            tracked.integrate(cpi);
+            fixed.integrate(cpi);
+        }
+        assert(tracked.cpis() == 4 && tracked.looks() == 4.0 * looks &&
+               tracked.score()[cell + 3] > fixed.score()[cell + 3] + 2.0 * looks);
+    }
+
+    {
+        // 250 Hz of Doppler at 1 GHz is 37.5 m/s. The Goertzel and chirp-z banks must agree over a dense search,
+        // and computeDoppler must keep the bins the full-FFT mask kept.
+        const size_t slow_time = 64;
+        const double bank_f0 = 1e9, bank_prf = 10e3;
+        std::vector<std::complex<double>> tone(slow_time);
+        for (size_t p = 0; p < slow_time; ++p) tone[p] = std::polar(1.0, 2.0 * M_PI * 250.0 * p / bank_prf);
+        std::vector<double> hypotheses = {0.0, 37.5, 100.0};
+        auto listed = SignalProcessor::dopplerFilterBank(tone, bank_f0, bank_prf, hypotheses);
+        assert(listed.peak() == 1 && std::abs(listed.power[1] - 64.0 * 64.0) < 1e-6);
+
+        auto by_goertzel = SignalProcessor::dopplerFilterBank(tone, bank_f0, bank_prf, -300.0, 300.0, 601,
+                                                              DopplerBankMethod::Goertzel);
+        auto by_chirp_z = SignalProcessor::dopplerFilterBank(tone, bank_f0, bank_prf, -300.0, 300.0, 601,
+                                                             DopplerBankMethod::ChirpZ);
+        assert(by_chirp_z.velocities == by_goertzel.velocities && by_chirp_z.velocities.front() == -300.0);
+        for (size_t k = 0; k < by_goertzel.power.size(); ++k) {
+            assert(std::abs(by_chirp_z.power[k] - by_goertzel.power[k]) < 1e-6 * 64.0 * 64.0 && "Chirp-z bank differs");
+        }
+        assert(std::abs(by_chirp_z.velocities[by_chirp_z.peak()] - 37.5) <= 0.5);
+
+        auto doppler_input = noisy;
+        auto masked = SignalProcessor::computeDoppler(doppler_input, 1e9, 1e9, 5e4);
+        std::vector<std::complex<double>> full(doppler_input.begin(), doppler_input.end());
+        SignalProcessor::fft(full);
+        for (size_t i = 0; i < full.size(); ++i) {
+            double freq = i * 1e9 / full.size();
+            std::complex<double> expected = std::abs(freq - 2 * 5e4 * 1e9 / 3.0e8) < 1e9 / full.size() ? full[i] : 0.0;
+            assert(std::abs(masked[i] - expected) < 1e-6 * (1.0 + std::abs(expected)) && "computeDoppler changed");
+        }
+    }
+
+    {
+        // Stationary clutter in the first half of the cells: the two-pulse canceller removes it exactly and passes a
+        // target at half the PRF with gain 2 (sqrt 2 after unit-noise scaling). A clutter map cancels only the
+        // cluttered half and leaves noise-only cells as they were.
+        const size_t mti_pulses = 32, mti_cells = 600, clutter_edge = 300, mover = 100;
+        auto clutterCPI = [&](uint64_t seed, double noise_power) {
+            PulseMatrix cpi(mti_pulses, mti_cells);
+            RandomStream(seed).addComplexGaussian<double>(cpi.samples(), std::sqrt(noise_power / 2.0));
+            for (size_t p = 0; p < mti_pulses; ++p) {
+                for (size_t r = 0; r < clutter_edge; ++r) cpi(p, r) += std::polar(10.0, 0.01 * r);
+                cpi(p, mover) += p % 2 ? -1.0 : 1.0;
+            }
+            return cpi;
+        };
+        PulseMatrix clean = clutterCPI(50, 0.0);
+        MTIFilter canceller({MTIType::TwoPulse});
+        bool cancelled = canceller.apply(clean);
+        assert(cancelled && clean.numPulses() == mti_pulses - 1 && canceller.cancelledCells() == mti_cells);
+        assert(std::abs(clean(3, 10)) < 1e-9 && std::abs(std::abs(clean(3, mover)) - 2.0 / std::sqrt(2.0)) < 1e-9);
+        MTIConfig fir{MTIType::FIR, {1.0, -3.0, 3.0, -1.0}};
+        MTIFilter four_pulse(fir);
+        double energy = 0.0;
+        for (double tap : four_pulse.taps()) energy += tap * tap;
+        assert(four_pulse.taps().size() == 4 && std::abs(energy - 1.0) < 1e-12);
+        PulseMatrix short_cpi(3, 8);
+        cancelled = four_pulse.apply(short_cpi);
+        assert(!cancelled && short_cpi.numPulses() == 3);
+
+        MTIConfig mapped;
+        mapped.clutter_map = true;
+        MTIFilter clutter_map(mapped);
+        for (uint64_t k = 0; k < 3; ++k) {
+            PulseMatrix cpi = clutterCPI(51 + k, 1.0);
+            PulseMatrix input = cpi;
+            cancelled = clutter_map.apply(cpi);
+            assert(cancelled);
+            assert(clutter_map.cancelledCells() == clutter_edge && "Clutter map missed the clutter edge");
+            assert(std::norm(cpi(4, 10)) < 10.0 && cpi(4, 400) == input(5, 400));
+        }
+        assert(clutter_map.inputMap()[10] > 50.0 * clutter_map.residualMap()[10]);
+
+        GraphConfig mti_graph;
+        std::string error;
+        bool mti_parsed = ProcessingGraph::parse("[pipeline]\nstages = scene, noise, clutter, mti, matched_filter, rd_map, "
+                                                 "cfar2d\n[mti]\ntype = fir\ncoefficients = 1, -2, 1\nclutter_map = true\n",
+                                                 mti_graph, error) &&
+                          ProcessingGraph::validate(mti_graph, error);
+        assert(mti_parsed && "MTI graph rejected");
+        assert(mti_graph.mti.clutter_map && mti_graph.mti.coefficients.size() == 3);
+        assert(ProcessingGraph::describe(ProcessingGraph::plan(mti_graph)) ==
+               "scene -> noise -> clutter -> mti -> matched_filter+rd_map -> cfar2d");
+        size_t mti_runs = 0;
+        GraphRunner(mti_graph).run([&](size_t, const GraphResult&) { ++mti_runs; });
+        assert(mti_runs == 1);
+        mti_graph.stages = {GraphStage::Scene, GraphStage::RangeDopplerMap, GraphStage::MTI};
+        mti_parsed = ProcessingGraph::validate(mti_graph, error);
+        assert(!mti_parsed && error.find("mti") != std::string::npos);
+    }
+
+    {
+        // A Gaussian mainlobe centred between cells is one target whose log-parabolic fit recovers the centre;
+        // detections two cells apart stay separate unless range_gap allows the gap. On a map, clusters join
+        // diagonally and across the Doppler wrap.
+        std::vector<double> profile(512, 1.0);
+        for (size_t i = 190; i < 212; ++i) profile[i] += 1000.0 * std::exp(-std::pow(i - 200.3, 2) / 2.0);
+        TargetExtractor extractor;
+        std::vector<size_t> lobe = {197, 198, 199, 200, 201, 202, 203};
+        auto lobe_targets = extractor.extract(std::span<const double>(profile), lobe, 2.0);
+        assert(lobe_targets.size() == 1 && lobe_targets[0].cells == 7);
+        assert(std::abs(lobe_targets[0].range_bin - 200.3) < 0.01 && std::abs(lobe_targets[0].range - 400.6) < 0.02);
+        assert(std::abs(lobe_targets[0].snr_db - 10.0 * std::log10(lobe_targets[0].peak_power)) < 0.5);
+        std::vector<size_t> gapped = {100, 101, 102, 104, 300};
+        assert(extractor.extract(std::span<const double>(profile), gapped, 1.0).size() == 3);
+        ExtractionConfig loose;
+        loose.range_gap = 2;
+        assert(TargetExtractor(loose).extract(std::span<const double>(profile), gapped, 1.0).size() == 2);
+
+        RangeDopplerMap cells_map;
+        cells_map.num_range_bins = 64;
+        cells_map.num_doppler_bins = 16;
+        cells_map.range_resolution = 1.5;
+        cells_map.velocity_resolution = 2.0;
+        cells_map.data.assign(64 * 16, 1.0);
+        cells_map.data[10 * 16 + 0] = 30.0;
+        cells_map.data[31 * 16 + 9] = 20.0;
+        std::vector<Detection2D> map_cells = {{10, 0}, {10, 15}, {11, 0}, {30, 8}, {31, 9}, {50, 4}};
+        auto map_targets = extractor.extract(cells_map, map_cells);
+        assert(map_targets.size() == 3 && map_targets[0].cells == 3 && map_targets[1].cells == 2);
+        assert(map_targets[0].range_bin == 10.0 && std::abs(map_targets[0].velocity - (0.0 - 8.0) * 2.0) < 1e-9);
+        assert(std::abs(map_targets[1].snr_db - 20.0 * std::log10(20.0)) < 1e-9 && map_targets[2].cells == 1);
+        assert(extractor.reports().data() == map_targets.data());
+    }
+
+    {
+        // Streaming statistics match a direct computation and do not depend on how the samples were split; the
+        // pyramid envelope equals the one-pass envelope when columns fall on block edges, and so does the
+        // range-Doppler block-max.
+        std::vector<std::complex<double>> capture(1 << 17);
+        RandomStream(60).addComplexGaussian<double>(capture, 1.0);
+        for (auto& x : capture) x += std::complex<double>(0.5, -0.25);
+        capture[99999] = {40.0, 30.0};
+        double direct_power = 0.0;
+        std::complex<double> direct_sum = 0.0;
+        std::vector<double> magnitudes;
+        for (const auto& x : capture) {
+            direct_power += std::norm(x);
+            direct_sum += x;
+            magnitudes.push_back(std::abs(x));
+        }
+        direct_power /= capture.size();
+        std::complex<double> direct_mean = direct_sum / static_cast<double>(capture.size());
+        SignalStats stats = SignalAnalyzer::computeStats(capture);
+        assert(stats.count == capture.size() && stats.peak_index == 99999 && std::abs(stats.peak - 50.0) < 1e-12);
+        assert(std::abs(stats.mean_power - direct_power) < 1e-9 && std::abs(stats.mean - direct_mean) < 1e-12);
+        assert(std::abs(stats.variance - (direct_power - std::norm(direct_mean))) < 1e-9);
+        std::sort(magnitudes.begin(), magnitudes.end());
+        assert(std::abs(stats.median / magnitudes[magnitudes.size() / 2] - 1.0) < 0.02);
+        assert(std::abs(stats.p99 / magnitudes[magnitudes.size() * 99 / 100] - 1.0) < 0.02);
+        StreamingStats first, second;
+        first.push(std::span(capture).first(1000));
+        second.push(std::span(capture).subspan(1000));
+        first.merge(second);
+        SignalStats merged = first.stats();
+        assert(merged.peak_index == 99999 && merged.median == stats.median && merged.p90 == stats.p90);
+
+        std::vector<double> low, high, pyramid_low, pyramid_high;
+        SignalAnalyzer::envelope(capture, 64, low, high);
+        WaveformPyramid pyramid(capture);
+        pyramid.envelope(0, capture.size(), 64, pyramid_low, pyramid_high);
+        assert(pyramid.levels() == 12 && high.size() == 64 && high[99999 * 64 / capture.size()] == 50.0);
+        for (size_t c = 0; c < 64; ++c) {
+            assert(std::abs(pyramid_high[c] / high[c] - 1.0) < 1e-6 && std::abs(pyramid_low[c] - low[c]) < 1e-6);
+        }
+        pyramid.envelope(99990, 100010, 80, pyramid_low, pyramid_high);
+        assert(pyramid_high.size() == 20 && pyramid_high[9] == 50.0);
+
+        RangeDopplerMap wide;
+        wide.num_range_bins = 4096;
+        wide.num_doppler_bins = 32;
+        wide.data.resize(4096 * 32);
+        RandomStream(61).fillGaussian<double>(wide.data, 1.0);
+        for (double& cell : wide.data) cell = std::abs(cell);
+        wide.data[3000 * 32 + 7] = 100.0;
+        std::vector<double> direct_cells, pyramid_cells;
+        SignalAnalyzer::blockMax(wide, 32, 16, direct_cells);
+        RangeDopplerPyramid map_pyramid(wide);
+        map_pyramid.render(0, 4096, 32, 16, pyramid_cells);
+        assert(direct_cells.size() == 32 * 16 && direct_cells[3000 * 32 / 4096 * 16 + 3] == 100.0);
+        for (size_t i = 0; i < direct_cells.size(); ++i) {
+            assert(std::abs(pyramid_cells[i] - direct_cells[i]) < 1e-5 * direct_cells[i]);
+        }
+    }
+
+    {
+        // The C interface works on caller buffers in place and matches the C++ chain; strided buffers give the
+        // same results as contiguous ones.
+        radar_context* context = radar_context_create(0);
+        assert(context && radar_api_version() == RADAR_API_VERSION);
+        size_t chirp_length = radar_chirp_length(10.0e-6, 20.0e6);
+        std::vector<std::complex<double>> chirp(chirp_length), strided_chirp(2 * chirp_length);
+        int status = radar_generate_chirp(context, 1.0e6, 5.0e6, 10.0e-6, 20.0e6,
+                                          reinterpret_cast<double*>(chirp.data()), chirp_length, 1);
+        assert(status == RADAR_OK);
+        status = radar_generate_chirp(context, 1.0e6, 5.0e6, 10.0e-6, 20.0e6,
+                                      reinterpret_cast<double*>(strided_chirp.data()), chirp_length, 2);
+        assert(status == RADAR_OK);
+        assert(chirp == SignalGenerator::generateChirp(1.0e6, 5.0e6, 10.0e-6, 20.0e6) && strided_chirp[198] == chirp[99]);
+        status = radar_generate_chirp(context, 1.0e6, 5.0e6, 10.0e-6, 20.0e6, reinterpret_cast<double*>(chirp.data()),
+                                      chirp_length - 1, 1);
+        assert(status == RADAR_ERROR_ARGUMENT);
+
+        radar_reference* reference = radar_reference_create(reinterpret_cast<const double*>(chirp.data()), chirp_length,
+                                                            1, 0, RADAR_WINDOW_HAMMING, 0.0);
+        auto spectrum = SignalProcessor::prepareReference(chirp, 0, {WindowType::Hamming});
+        BasicPulseMatrix<double> cpi(16, 1000);
+        RandomStream(70).addComplexGaussian<double>(cpi.samples(), 1.0);
+        for (size_t p = 0; p < 16; ++p) {
+            for (size_t i = 0; i < chirp_length; ++i) cpi(p, 300 + i) += 4.0 * chirp[i];
+        }
+        BasicPulseMatrix<double> expected_cpi = cpi;
+        std::vector<std::complex<double>> first_pulse(cpi.row(0).begin(), cpi.row(0).end());
+        std::vector<std::complex<double>> strided_out(2000);
+        for (size_t i = 0; i < 1000; ++i) strided_out[2 * i] = first_pulse[i];
+        status = radar_matched_filter(context, reference, reinterpret_cast<const double*>(strided_out.data()), 2,
+                                      reinterpret_cast<double*>(strided_out.data()), 2, 1000);
+        assert(status == RADAR_OK);
+        status = radar_matched_filter_cpi(context, reference, reinterpret_cast<double*>(cpi.data()), 16, 1000, 1000);
+        assert(status == RADAR_OK);
+        SignalProcessor::matchedFilter(expected_cpi, spectrum);
+        assert(cpi.samples().size() == expected_cpi.samples().size() &&
+               std::equal(cpi.samples().begin(), cpi.samples().end(), expected_cpi.samples().begin()));
+        auto expected_first = SignalProcessor::matchedFilter(first_pulse, spectrum);
+        assert(strided_out[2 * 999] == expected_first[999] && strided_out[0] == expected_first[0]);
+        status = radar_matched_filter_cpi(context, reference, reinterpret_cast<double*>(cpi.data()), 16, 1000, 500);
+        assert(status == RADAR_ERROR_ARGUMENT);
+
+        std::vector<double> magnitudes(16 * 1000);
+        status = radar_range_doppler(context, reinterpret_cast<const double*>(cpi.data()), 16, 1000, 1000,
+                                     RADAR_WINDOW_HANN, 0.0, magnitudes.data());
+        assert(status == RADAR_OK);
+        RangeDopplerMap map = SignalProcessor::rangeDopplerMap(cpi, 1.0e9, 20.0e6, 1.0e3);
+        assert(magnitudes == map.data);
+
+        std::vector<size_t> hits(4), range_bins(4), doppler_bins(4);
+        ptrdiff_t found = radar_cfar(context, reinterpret_cast<const double*>(cpi.data()), 1000, 1, 2, 16, 1e-6,
+                                     RADAR_CFAR_CELL_AVERAGING, 0, hits.data(), hits.size());
+        auto expected_hits = SignalProcessor::cfarDetection(cpi.row(0), 2, 16, 1e-6);
+        assert(found == static_cast<ptrdiff_t>(expected_hits.size()) && found > 0);
+        assert(std::equal(hits.begin(), hits.begin() + std::min<size_t>(found, 4), expected_hits.begin()));
+        found = radar_cfar_2d(context, magnitudes.data(), 1000, 16, 1, 1, 4, 4, 1e-6, range_bins.data(),
+                              doppler_bins.data(), range_bins.size());
+        auto expected_2d = SignalProcessor::cfarDetection2D(map, 1, 1, 4, 4, 1e-6);
+        assert(found == static_cast<ptrdiff_t>(expected_2d.size()) && found > 0);
+        assert(range_bins[0] == expected_2d[0].range_bin && doppler_bins[0] == expected_2d[0].doppler_bin);
+        found = radar_cfar(context, nullptr, 1000, 1, 2, 16, 1e-6, 0, 0, nullptr, 0);
+        assert(found == RADAR_ERROR_ARGUMENT);
+        radar_reference_destroy(reference);
+        radar_context_destroy(context);
+    }
+
     std::cout << "All tests passed!\n";
 }
 
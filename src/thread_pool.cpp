@@ -0,0 +1,138 @@
+#include "thread_pool.h"
+#include "metrics.h"
+#include <algorithm>
+#include <latch>
+
+namespace RadarToolkit {
+
+namespace {
+thread_local ThreadPool* current_pool = nullptr;
+thread_local ThreadPool* scoped_pool = nullptr;
+thread_local size_t current_queue = 0;
+}
+
+ThreadPool::ThreadPool(size_t num_threads) {
+    if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t i = 0; i < num_threads; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t i = 1; i < num_threads; ++i) {
+        workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+ThreadPool& ThreadPool::shared() {
+    if (current_pool) return *current_pool;
+    if (scoped_pool) return *scoped_pool;
+    static ThreadPool pool;
+    return pool;
+}
+
+ThreadPool::Scope::Scope(ThreadPool& pool) : previous(scoped_pool) {
+    scoped_pool = &pool;
+}
+
+ThreadPool::Scope::~Scope() {
+    scoped_pool = previous;
+}
+
+size_t ThreadPool::homeQueue() const {
+    return current_pool == this ? current_queue : 0;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    current_pool = this;
+    current_queue = index;
+    while (true) {
+        if (runPendingTask(index)) continue;
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        cv.wait(lock, [this] { return stopping || pending.load() > 0; });
+        if (stopping && pending.load() == 0) return;
+    }
+}
+
+void ThreadPool::WorkQueue::pushBack(const Task& task) {
+    if (count == ring.size()) {
+        std::vector<Task> grown(2 * ring.size());
+        for (size_t i = 0; i < count; ++i) grown[i] = ring[(head + i) % ring.size()];
+        ring.swap(grown);
+        head = 0;
+    }
+    ring[(head + count++) % ring.size()] = task;
+}
+
+bool ThreadPool::WorkQueue::popBack(Task& task) {
+    if (count == 0) return false;
+    task = ring[(head + --count) % ring.size()];
+    return true;
+}
+
+bool ThreadPool::WorkQueue::popFront(Task& task) {
+    if (count == 0) return false;
+    task = ring[head];
+    head = (head + 1) % ring.size();
+    --count;
+    return true;
+}
+
+bool ThreadPool::runPendingTask(size_t home) {
+    Task task;
+    bool found;
+    {
+        WorkQueue& own = *queues[home];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        found = own.popBack(task);
+    }
+    for (size_t offset = 1; !found && offset < queues.size(); ++offset) {
+        WorkQueue& victim = *queues[(home + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        found = victim.popFront(task);
+    }
+    if (!found) return false;
+    pending.fetch_sub(1);
+    RADAR_METRIC_TASK_SCOPE();
+    task.body.invoke(task.body.object, task.begin, task.end);
+    task.done->count_down();
+    return true;
+}
+
+void ThreadPool::run(size_t count, size_t grain, RangeBody body) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+    size_t chunks = std::min((count + grain - 1) / grain, 4 * size());
+    if (workers.empty() || chunks <= 1) {
+        body.invoke(body.object, 0, count);
+        return;
+    }
+
+    size_t home = homeQueue();
+    std::latch done(static_cast<std::ptrdiff_t>(chunks));
+    {
+        // pending is raised before the tasks become visible so a thief can never drive it below zero.
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        pending.fetch_add(chunks - 1);
+        for (size_t c = 1; c < chunks; ++c) {
+            WorkQueue& queue = *queues[(home + c) % queues.size()];
+            std::lock_guard<std::mutex> queue_lock(queue.mutex);
+            queue.pushBack({body, &done, c * count / chunks, (c + 1) * count / chunks});
+        }
+    }
+    cv.notify_all();
+
+    body.invoke(body.object, 0, count / chunks);
+    done.count_down();
+    // Help drain the queues (this also keeps nested parallelFor calls from deadlocking), then block.
+    while (!done.try_wait() && runPendingTask(home)) {}
+    done.wait();
+}
+
+}
\ No newline at end of file
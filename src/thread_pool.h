@@ -0,0 +1,88 @@
+#pragma once
+#include <vector>
+#include <latch>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace RadarToolkit {
+
+// Work-stealing pool: each worker owns a deque, runs its own tasks newest-first and steals the
+// oldest tasks from other workers when it runs dry, so uneven chunks balance themselves.
+class ThreadPool {
+public:
+    // num_threads counts the calling thread, which always takes part in parallelFor.
+    explicit ThreadPool(size_t num_threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // The pool parallel kernels should use: the pool running the calling thread, else the innermost
+    // Scope on this thread, else a process-wide pool sized to the hardware.
+    static ThreadPool& shared();
+
+    // Routes shared() on the calling thread to `pool` for the scope's lifetime.
+    class Scope {
+    public:
+        explicit Scope(ThreadPool& pool);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ThreadPool* previous;
+    };
+
+    size_t size() const { return workers.size() + 1; }
+    // Splits [0, count) into contiguous chunks of at least `grain` items and blocks until all are done.
+    // body(begin, end) is called by reference, never copied, so scheduling does not touch the heap.
+    template <typename F>
+    void parallelFor(size_t count, F&& body, size_t grain = 1) {
+        using Body = std::remove_reference_t<F>;
+        run(count, grain, {const_cast<void*>(static_cast<const void*>(std::addressof(body))),
+                           [](void* object, size_t begin, size_t end) { (*static_cast<Body*>(object))(begin, end); }});
+    }
+
+private:
+    struct RangeBody {
+        void* object;
+        void (*invoke)(void* object, size_t begin, size_t end);
+    };
+
+    struct Task {
+        RangeBody body;
+        std::latch* done;
+        size_t begin;
+        size_t end;
+    };
+
+    // A ring that only ever grows, so steady-state scheduling makes no allocations.
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<Task> ring = std::vector<Task>(64);
+        size_t head = 0;
+        size_t count = 0;
+
+        void pushBack(const Task& task);
+        bool popBack(Task& task);
+        bool popFront(Task& task);
+    };
+
+    // queues[0] is shared by threads outside the pool; queues[i] belongs to worker i.
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pending{0};
+    std::mutex sleep_mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+
+    void run(size_t count, size_t grain, RangeBody body);
+    size_t homeQueue() const;
+    bool runPendingTask(size_t home);
+    void workerLoop(size_t index);
+};
+
+}
\ No newline at end of file
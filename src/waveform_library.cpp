@@ -0,0 +1,186 @@
+#include "waveform_library.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace RadarToolkit {
+
+constexpr double PI = 3.14159265358979323846;
+// The chirp recurrence is re-anchored to an exactly evaluated phase at this interval to bound drift.
+constexpr size_t ANCHOR_INTERVAL = 256;
+
+static size_t chipCount(const WaveformParams& params) {
+    size_t m = static_cast<size_t>(std::max(params.code_length, 0));
+    switch (params.type) {
+        case WaveformType::Barker: return BasicWaveformLibrary<double>::barkerSequence(params.code_length).size();
+        case WaveformType::Frank:
+        case WaveformType::P1:
+        case WaveformType::P2: return m * m;
+        case WaveformType::P3:
+        case WaveformType::P4: return m;
+        default: return 0;
+    }
+}
+
+static size_t samplesPerChip(const WaveformParams& params, size_t chips) {
+    double chip_rate = params.chip_rate;
+    if (chip_rate <= 0.0 && params.duration > 0.0 && chips > 0) chip_rate = chips / params.duration;
+    if (chip_rate <= 0.0) chip_rate = params.bandwidth;
+    if (chip_rate <= 0.0 || params.fs <= 0.0) return 1;
+    return std::max<size_t>(1, static_cast<size_t>(std::llround(params.fs / chip_rate)));
+}
+
+static std::complex<double> unitPhasor(double cycles) {
+    double angle = 2.0 * PI * (cycles - std::floor(cycles));
+    return {std::cos(angle), std::sin(angle)};
+}
+
+template <typename T>
+void BasicWaveformLibrary<T>::quadraticPhase(std::span<std::complex<T>> out, double a, double b) {
+    // Each sample is the previous one times a rotator that itself advances by a constant factor: two complex
+    // multiplies per sample instead of cos and sin.
+    std::complex<double> chirp_rate = unitPhasor(2.0 * b);
+    for (size_t start = 0; start < out.size(); start += ANCHOR_INTERVAL) {
+        double n = static_cast<double>(start);
+        std::complex<double> value = unitPhasor(a * n + b * n * n);
+        std::complex<double> step = unitPhasor(a + b * (2.0 * n + 1.0));
+        size_t end = std::min(out.size(), start + ANCHOR_INTERVAL);
+        for (size_t i = start; i < end; ++i) {
+            out[i] = std::complex<T>(value);
+            value *= step;
+            step *= chirp_rate;
+        }
+    }
+}
+
+template <typename T>
+static void generateLFM(const WaveformParams& params, std::span<std::complex<T>> out) {
+    double a = params.f0 / params.fs;
+    double b = 0.5 * params.bandwidth / params.duration / (params.fs * params.fs);
+    BasicWaveformLibrary<T>::quadraticPhase(out, a, b);
+}
+
+template <typename T>
+static void generateNLFM(const WaveformParams& params, std::span<std::complex<T>> out) {
+    // Tangent FM: f(u) = (B / 2) tan(2 beta u) / tan(beta) for u = t / T - 1/2, integrated in closed form.
+    double beta = std::clamp(params.nlfm_beta, 1e-6, PI / 2.0 - 1e-6);
+    double scale = params.bandwidth * params.duration / (4.0 * beta * std::tan(beta));
+    double edge = std::log(std::cos(beta));
+    for (size_t i = 0; i < out.size(); ++i) {
+        double t = i / params.fs;
+        double u = t / params.duration - 0.5;
+        double cycles = params.f0 * t - scale * (std::log(std::cos(2.0 * beta * u)) - edge);
+        out[i] = std::complex<T>(unitPhasor(cycles));
+    }
+}
+
+template <typename T>
+std::vector<int> BasicWaveformLibrary<T>::barkerSequence(int code_length) {
+    switch (code_length) {
+        case 2: return {1, -1};
+        case 3: return {1, 1, -1};
+        case 4: return {1, 1, -1, 1};
+        case 5: return {1, 1, 1, -1, 1};
+        case 7: return {1, 1, 1, -1, -1, 1, -1};
+        case 11: return {1, 1, 1, -1, -1, -1, 1, -1, -1, 1, -1};
+        case 13: return {1, 1, 1, 1, 1, -1, -1, 1, 1, -1, 1, -1, 1};
+        default: return {};
+    }
+}
+
+template <typename T>
+std::vector<double> BasicWaveformLibrary<T>::polyphaseCode(WaveformType type, int code_length) {
+    if (code_length <= 0) return {};
+    double m = code_length;
+    std::vector<double> phases;
+    if (type == WaveformType::Frank || type == WaveformType::P1 || type == WaveformType::P2) {
+        phases.reserve(code_length * code_length);
+        for (int i = 1; i <= code_length; ++i) {
+            for (int j = 1; j <= code_length; ++j) {
+                if (type == WaveformType::Frank) phases.push_back(2.0 * PI * (i - 1) * (j - 1) / m);
+                else if (type == WaveformType::P1) phases.push_back(-PI / m * (m - (2.0 * i - 1.0)) * ((i - 1) * m + (j - 1)));
+                else phases.push_back((PI / (2.0 * m) * (m - 1.0) - PI / m * (i - 1)) * (m + 1.0 - 2.0 * j));
+            }
+        }
+    } else if (type == WaveformType::P3 || type == WaveformType::P4) {
+        phases.reserve(code_length);
+        for (int n = 0; n < code_length; ++n) {
+            double phase = PI * n * n / m;
+            if (type == WaveformType::P4) phase -= PI * n;
+            phases.push_back(phase);
+        }
+    }
+    return phases;
+}
+
+template <typename T>
+size_t BasicWaveformLibrary<T>::length(const WaveformParams& params) {
+    if (params.type == WaveformType::LFM || params.type == WaveformType::NLFM) {
+        return params.fs > 0.0 && params.duration > 0.0 ? static_cast<size_t>(params.duration * params.fs) : 0;
+    }
+    size_t chips = chipCount(params);
+    return chips * samplesPerChip(params, chips);
+}
+
+template <typename T>
+bool BasicWaveformLibrary<T>::generate(const WaveformParams& params, std::span<std::complex<T>> out) {
+    if (out.size() != length(params)) return false;
+    if (out.empty()) return true;
+
+    switch (params.type) {
+        case WaveformType::LFM:
+            generateLFM(params, out);
+            return true;
+        case WaveformType::NLFM:
+            generateNLFM(params, out);
+            return true;
+        case WaveformType::Barker: {
+            auto chips = barkerSequence(params.code_length);
+            size_t oversample = out.size() / chips.size();
+            for (size_t c = 0; c < chips.size(); ++c) {
+                std::fill_n(out.begin() + c * oversample, oversample, std::complex<T>(static_cast<T>(chips[c]), T(0)));
+            }
+            return true;
+        }
+        default: {
+            auto phases = polyphaseCode(params.type, params.code_length);
+            size_t oversample = out.size() / phases.size();
+            for (size_t c = 0; c < phases.size(); ++c) {
+                std::complex<T> chip(static_cast<T>(std::cos(phases[c])), static_cast<T>(std::sin(phases[c])));
+                std::fill_n(out.begin() + c * oversample, oversample, chip);
+            }
+            return true;
+        }
+    }
+}
+
+template <typename T>
+std::shared_ptr<const typename BasicWaveformLibrary<T>::Waveform> BasicWaveformLibrary<T>::get(const WaveformParams& params,
+                                                                                           const WindowSpec& range_window) {
+    static std::mutex mutex;
+    static std::map<std::pair<WaveformParams, WindowSpec>, std::shared_ptr<const Waveform>> cache;
+
+    auto key = std::make_pair(params, range_window);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = cache.find(key);
+        if (it != cache.end()) return it->second;
+    }
+
+    auto waveform = std::make_shared<Waveform>();
+    waveform->samples.resize(length(params));
+    generate(params, waveform->samples);
+    if (!waveform->samples.empty()) {
+        waveform->spectrum = BasicSignalProcessor<T>::prepareReference(waveform->samples, 0, range_window);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.emplace(key, std::move(waveform)).first->second;
+}
+
+template class BasicWaveformLibrary<float>;
+template class BasicWaveformLibrary<double>;
+
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+#include <vector>
+#include <complex>
+#include <span>
+#include <memory>
+#include <compare>
+#include "signal_processor.h"
+
+namespace RadarToolkit {
+
+enum class WaveformType { LFM, NLFM, Barker, Frank, P1, P2, P3, P4 };
+
+struct WaveformParams {
+    WaveformType type = WaveformType::LFM;
+    double f0 = 0.0;
+    double bandwidth = 0.0;
+    double duration = 0.0;
+    double fs = 0.0;
+    // Barker: code length. Frank, P1, P2: order M (M^2 chips). P3, P4: number of chips.
+    int code_length = 13;
+    // Chips per second for phase codes; 0 derives it from duration, then bandwidth, else one chip per sample.
+    double chip_rate = 0.0;
+    // Tangent-FM shape for NLFM; larger values put more time near the centre frequency.
+    double nlfm_beta = 1.2;
+
+    auto operator<=>(const WaveformParams&) const = default;
+};
+
+// Generates LFM/NLFM chirps and Barker/polyphase codes into caller buffers, and caches each waveform with
+// its matched-filter spectrum so repeated requests for the same parameters cost a lookup.
+template <typename T>
+class BasicWaveformLibrary {
+public:
+    struct Waveform {
+        std::vector<std::complex<T>> samples;
+        BasicReferenceSpectrum<T> spectrum;
+    };
+
+    // range_window tapers the cached matched-filter spectrum; the samples themselves are never windowed.
+    static std::shared_ptr<const Waveform> get(const WaveformParams& params, const WindowSpec& range_window = {});
+
+    static size_t length(const WaveformParams& params);
+    // Writes the waveform into out, which must hold length(params) samples; returns false otherwise.
+    static bool generate(const WaveformParams& params, std::span<std::complex<T>> out);
+
+    // +1/-1 chips for lengths 2, 3, 4, 5, 7, 11 and 13; empty for any other length.
+    static std::vector<int> barkerSequence(int code_length);
+    // Chip phases in radians for Frank and P1-P4 codes.
+    static std::vector<double> polyphaseCode(WaveformType type, int code_length);
+    // e^{j 2 pi (a n + b n^2)} for n = 0..out.size()-1, the phase of an LFM chirp, by a rotator recurrence in
+    // double that is re-anchored to an exactly evaluated phase at a fixed interval to bound drift.
+    static void quadraticPhase(std::span<std::complex<T>> out, double a, double b);
+};
+
+using WaveformLibrary = BasicWaveformLibrary<double>;
+using WaveformLibraryF = BasicWaveformLibrary<float>;
+
+}
\ No newline at end of file
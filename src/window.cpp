@@ -0,0 +1,142 @@
+#include "window.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace RadarToolkit {
+
+constexpr double PI = 3.14159265358979323846;
+
+static double cosineSum(std::initializer_list<double> coefficients, size_t n, size_t length) {
+    double x = 2.0 * PI * n / (length - 1);
+    double value = 0.0;
+    double sign = 1.0;
+    size_t order = 0;
+    for (double a : coefficients) {
+        value += sign * a * std::cos(order++ * x);
+        sign = -sign;
+    }
+    return value;
+}
+
+// Taylor weights from the Fm coefficients of the nbar-term pattern (as in MATLAB's taylorwin).
+static std::vector<double> taylor(size_t length, double sidelobe_db, int nbar) {
+    nbar = std::max(nbar, 2);
+    double a = std::acosh(std::pow(10.0, sidelobe_db / 20.0)) / PI;
+    double sigma2 = nbar * nbar / (a * a + (nbar - 0.5) * (nbar - 0.5));
+    std::vector<double> f(nbar, 0.0);
+    for (int m = 1; m < nbar; ++m) {
+        double numerator = 1.0, denominator = 1.0;
+        for (int i = 1; i < nbar; ++i) {
+            numerator *= 1.0 - m * m / (sigma2 * (a * a + (i - 0.5) * (i - 0.5)));
+            if (i != m) denominator *= 1.0 - static_cast<double>(m * m) / (i * i);
+        }
+        f[m] = ((m % 2) ? 0.5 : -0.5) * numerator / denominator;
+    }
+    std::vector<double> w(length);
+    for (size_t n = 0; n < length; ++n) {
+        double x = (n + 0.5) / length - 0.5;
+        w[n] = 1.0;
+        for (int m = 1; m < nbar; ++m) w[n] += 2.0 * f[m] * std::cos(2.0 * PI * m * x);
+    }
+    return w;
+}
+
+// Dolph-Chebyshev window from its frequency samples T_{N-1}(x0 cos(pi k / N)).
+static std::vector<double> chebyshev(size_t length, double sidelobe_db) {
+    double order = static_cast<double>(length - 1);
+    double x0 = std::cosh(std::acosh(std::pow(10.0, sidelobe_db / 20.0)) / order);
+    std::vector<double> spectrum(length);
+    for (size_t k = 0; k < length; ++k) {
+        double x = x0 * std::cos(PI * k / length);
+        spectrum[k] = std::abs(x) <= 1.0 ? std::cos(order * std::acos(x))
+                                         : std::cosh(order * std::acosh(std::abs(x))) * ((x < 0 && length % 2 == 0) ? -1.0 : 1.0);
+    }
+    double centre = order / 2.0;
+    std::vector<double> w(length);
+    for (size_t n = 0; n < length; ++n) {
+        double sum = 0.0;
+        for (size_t k = 0; k < length; ++k) sum += spectrum[k] * std::cos(2.0 * PI * k * (n - centre) / length);
+        w[n] = sum;
+    }
+    double peak = *std::max_element(w.begin(), w.end());
+    for (double& v : w) v /= peak;
+    return w;
+}
+
+static std::vector<double> compute(const WindowSpec& spec, size_t length) {
+    std::vector<double> w(length, 1.0);
+    if (length < 2) return w;
+    switch (spec.type) {
+        case WindowType::Rectangular:
+            break;
+        case WindowType::Hann:
+            for (size_t n = 0; n < length; ++n) w[n] = cosineSum({0.5, 0.5}, n, length);
+            break;
+        case WindowType::Hamming:
+            for (size_t n = 0; n < length; ++n) w[n] = cosineSum({0.54, 0.46}, n, length);
+            break;
+        case WindowType::BlackmanHarris:
+            for (size_t n = 0; n < length; ++n) w[n] = cosineSum({0.35875, 0.48829, 0.14128, 0.01168}, n, length);
+            break;
+        case WindowType::Taylor:
+            w = taylor(length, spec.parameter > 0.0 ? spec.parameter : 35.0, spec.taylor_nbar);
+            break;
+        case WindowType::Chebyshev:
+            w = chebyshev(length, spec.parameter > 0.0 ? spec.parameter : 60.0);
+            break;
+        case WindowType::Kaiser: {
+            double beta = spec.parameter > 0.0 ? spec.parameter : 6.0;
+            double norm = std::cyl_bessel_i(0.0, beta);
+            for (size_t n = 0; n < length; ++n) {
+                double x = 2.0 * n / (length - 1) - 1.0;
+                w[n] = std::cyl_bessel_i(0.0, beta * std::sqrt(std::max(0.0, 1.0 - x * x))) / norm;
+            }
+            break;
+        }
+    }
+    return w;
+}
+
+template <typename T>
+std::shared_ptr<const std::vector<T>> BasicWindowFunction<T>::get(const WindowSpec& spec, size_t length) {
+    static std::mutex mutex;
+    static std::map<std::pair<WindowSpec, size_t>, std::shared_ptr<const std::vector<T>>> cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto key = std::make_pair(spec, length);
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second;
+
+    auto weights = compute(spec, length);
+    auto table = std::make_shared<const std::vector<T>>(weights.begin(), weights.end());
+    return cache.emplace(key, std::move(table)).first->second;
+}
+
+template <typename T>
+WindowLoss BasicWindowFunction<T>::loss(std::span<const T> window) {
+    WindowLoss result;
+    if (window.empty()) return result;
+    double sum = 0.0, sum_squares = 0.0;
+    std::complex<double> half_bin = 0.0;
+    size_t n = window.size();
+    for (size_t i = 0; i < n; ++i) {
+        sum += window[i];
+        sum_squares += static_cast<double>(window[i]) * window[i];
+        half_bin += static_cast<double>(window[i]) * std::polar(1.0, -PI * i / n);
+    }
+    if (sum == 0.0) return result;
+    result.coherent_gain = sum / n;
+    result.enbw_bins = n * sum_squares / (sum * sum);
+    result.processing_loss_db = 10.0 * std::log10(result.enbw_bins);
+    result.scalloping_loss_db = -20.0 * std::log10(std::abs(half_bin) / sum);
+    return result;
+}
+
+template class BasicWindowFunction<float>;
+template class BasicWindowFunction<double>;
+
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <span>
+#include <compare>
+
+namespace RadarToolkit {
+
+enum class WindowType { Rectangular, Hann, Hamming, BlackmanHarris, Taylor, Chebyshev, Kaiser };
+
+struct WindowSpec {
+    WindowType type = WindowType::Rectangular;
+    // Taylor and Chebyshev: peak sidelobe level in dB below the mainlobe (0 picks 35 and 60 dB).
+    // Kaiser: beta (0 picks 6).
+    double parameter = 0.0;
+    // Taylor: number of nearly constant-level sidelobes.
+    int taylor_nbar = 4;
+
+    auto operator<=>(const WindowSpec&) const = default;
+};
+
+// Corrections for the SNR a detector sees after windowing, relative to an untapered filter.
+struct WindowLoss {
+    double coherent_gain = 1.0;          // mean weight: amplitude of a bin-centred tone
+    double enbw_bins = 1.0;              // equivalent noise bandwidth
+    double processing_loss_db = 0.0;     // SNR loss for a bin-centred tone, 10 log10(ENBW)
+    double scalloping_loss_db = 0.0;     // extra loss for a tone halfway between bins
+};
+
+template <typename T>
+class BasicWindowFunction {
+public:
+    // Symmetric window of the given length; tables are computed once per (spec, length) and shared.
+    static std::shared_ptr<const std::vector<T>> get(const WindowSpec& spec, size_t length);
+    static WindowLoss loss(std::span<const T> window);
+};
+
+using WindowFunction = BasicWindowFunction<double>;
+using WindowFunctionF = BasicWindowFunction<float>;
+
+}
\ No newline at end of file
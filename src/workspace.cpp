@@ -0,0 +1,61 @@
+#include "workspace.h"
+#include <new>
+#include <algorithm>
+
+namespace RadarToolkit {
+
+namespace {
+
+std::byte* alignedBytes(size_t bytes) {
+    return static_cast<std::byte*>(::operator new(bytes, std::align_val_t(Workspace::ALIGNMENT)));
+}
+
+void releaseBytes(std::byte* bytes) {
+    ::operator delete(bytes, std::align_val_t(Workspace::ALIGNMENT));
+}
+
+}
+
+Workspace::Workspace(size_t bytes) {
+    resize(bytes);
+}
+
+Workspace::~Workspace() {
+    for (std::byte* spill : spills) releaseBytes(spill);
+    if (buffer) releaseBytes(buffer);
+}
+
+void Workspace::resize(size_t bytes) {
+    bytes = (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    if (buffer) releaseBytes(buffer);
+    buffer = bytes ? alignedBytes(bytes) : nullptr;
+    buffer_size = bytes;
+}
+
+void* Workspace::allocateBytes(size_t bytes) {
+    size_t size = (std::max<size_t>(bytes, 1) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    size_t start = offset.fetch_add(size);
+    size_t end = start + size;
+    size_t seen = peak.load();
+    while (end > seen && !peak.compare_exchange_weak(seen, end)) {}
+    if (end <= buffer_size) return buffer + start;
+
+    std::byte* spill = alignedBytes(size);
+    std::lock_guard<std::mutex> lock(spill_mutex);
+    spills.push_back(spill);
+    return spill;
+}
+
+Workspace::Frame::Frame(Workspace& workspace) : workspace(workspace), mark(workspace.offset.load()) {
+    ++workspace.depth;
+}
+
+Workspace::Frame::~Frame() {
+    workspace.offset.store(mark);
+    if (--workspace.depth > 0 || workspace.peak.load() <= workspace.buffer_size) return;
+    for (std::byte* spill : workspace.spills) releaseBytes(spill);
+    workspace.spills.clear();
+    workspace.resize(workspace.peak.load());
+}
+
+}
\ No newline at end of file
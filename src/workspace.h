@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace RadarToolkit {
+
+// Scratch arena for the processing chain. Functions that take a Workspace open a Frame and carve their
+// temporaries from it with allocate(), which is safe to call from several pool tasks at once; closing the
+// frame releases everything allocated inside it. A request that does not fit spills to the heap, and when
+// the outermost frame closes the arena regrows to the high-water mark, so once one CPI of a given
+// configuration has run, the chain makes no further allocations.
+class Workspace {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    explicit Workspace(size_t bytes = 0);
+    ~Workspace();
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+
+    // Uninitialized storage for count values, 64-byte aligned; valid until the enclosing frame closes.
+    template <typename U>
+    std::span<U> allocate(size_t count) {
+        static_assert(std::is_trivially_destructible_v<U> && alignof(U) <= ALIGNMENT);
+        return {static_cast<U*>(allocateBytes(count * sizeof(U))), count};
+    }
+
+    size_t capacity() const { return buffer_size; }
+    size_t highWater() const { return peak.load(); }
+
+    // Frames nest on the thread that owns the workspace; pool tasks inside a frame only allocate.
+    class Frame {
+    public:
+        explicit Frame(Workspace& workspace);
+        ~Frame();
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+    private:
+        Workspace& workspace;
+        size_t mark;
+    };
+
+private:
+    std::byte* buffer = nullptr;
+    size_t buffer_size = 0;
+    std::atomic<size_t> offset{0};
+    std::atomic<size_t> peak{0};
+    size_t depth = 0;
+    std::mutex spill_mutex;
+    std::vector<std::byte*> spills;
+
+    void* allocateBytes(size_t bytes);
+    void resize(size_t bytes);
+};
+
+}
\ No newline at end of file
@@ -91,6 +91,42 @@ def test_cfar_detection():
     assert detected_targets.any()  # There should be some detected targets
 
 
+def test_matched_filter_and_cfar():
+    radar = RadarSignalProcessor()
+    reference = np.exp(1j * np.pi * 50 * np.linspace(0, 1, 100)**2)
+    signal = 0.1 * (np.random.randn(2000) + 1j * np.random.randn(2000))
+    signal[700:800] += reference
+    compressed = radar.matched_filter(signal, reference)
+    assert len(compressed) == len(signal)
+    assert np.argmax(np.abs(compressed)) == 700  # Peak at the lag where the echo starts
+    assert 700 in radar.cfar_detect(compressed, guard_cells=2, training_cells=16, pfa=1e-6)
+
+
+def test_range_doppler():
+    radar = RadarSignalProcessor()
+    pulses = np.zeros((32, 100), dtype=complex)
+    pulses[:, 40] = np.exp(2j * np.pi * 0.25 * np.arange(32))  # A quarter cycle per pulse: Doppler bin 8
+    magnitudes = radar.range_doppler(pulses)
+    assert magnitudes.shape == (100, 32)  # Range bins x Doppler bins
+    assert np.unravel_index(np.argmax(magnitudes), magnitudes.shape) == (40, 16 + 8)
+
+
+def test_native_kernels_match_numpy():
+    radar = RadarSignalProcessor()
+    if radar.native is None:
+        return  # The C++ library is not built; the NumPy path is covered above
+    fallback = RadarSignalProcessor()
+    fallback.native = None
+    reference = np.exp(1j * np.pi * 50 * np.linspace(0, 1, 100)**2)
+    signal = np.random.randn(4000) + 1j * np.random.randn(4000)
+    assert np.allclose(radar.matched_filter(signal, reference), fallback.matched_filter(signal, reference))
+    assert np.allclose(radar.matched_filter(signal[::-2], reference), fallback.matched_filter(signal[::-2], reference))
+    compressed = fallback.matched_filter(signal, reference)
+    assert np.array_equal(radar.cfar_detect(compressed, 2, 16, 1e-3), fallback.cfar_detect(compressed, 2, 16, 1e-3))
+    pulses = np.random.randn(16, 300) + 1j * np.random.randn(16, 300)
+    assert np.allclose(radar.range_doppler(pulses), fallback.range_doppler(pulses))
+
+
 def test_process_multiple_targets():
     radar = RadarSignalProcessor()
     targets = [(1000, 50), (1500, 30), (2000, 10)]  # List of (range, velocity) tuples